@@ -0,0 +1,104 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Reports the number of allocations and allocated bytes per
+// connect/emit/disconnect operation. It's a different executable
+// because it replaces the global operator new.
+
+#include "obs.h"
+#include "../tests/alloc_counter.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+static void report(benchmark::State& state,
+                   std::size_t allocs, std::size_t bytes) {
+  const double ops = double(state.iterations());
+  state.counters["allocs"] = double(allocs) / ops;
+  state.counters["bytes"] = double(bytes) / ops;
+}
+
+template<typename Signal>
+static void BM_AllocConnect(benchmark::State& state) {
+  Signal sig;
+  std::size_t allocs = 0, bytes = 0;
+  for (auto _ : state) {
+    alloc_counter::scope scope;
+    obs::connection conn = sig.connect([](int){ });
+    allocs += scope.allocs();
+    bytes += scope.bytes();
+
+    state.PauseTiming();
+    conn.disconnect();
+    state.ResumeTiming();
+  }
+  report(state, allocs, bytes);
+}
+
+template<typename Signal>
+static void BM_AllocEmit(benchmark::State& state) {
+  Signal sig;
+  std::vector<obs::connection> conns;
+  for (int i=0; i<state.range(0); ++i)
+    conns.push_back(sig.connect([](int v){ benchmark::DoNotOptimize(v); }));
+  sig(0);
+
+  alloc_counter::scope scope;
+  for (auto _ : state)
+    sig(1);
+  report(state, scope.allocs(), scope.bytes());
+
+  for (auto& conn : conns)
+    conn.disconnect();
+}
+
+template<typename Signal>
+static void BM_AllocDisconnect(benchmark::State& state) {
+  Signal sig;
+  std::size_t allocs = 0, bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    obs::connection conn = sig.connect([](int){ });
+    state.ResumeTiming();
+
+    alloc_counter::scope scope;
+    conn.disconnect();
+    allocs += scope.allocs();
+    bytes += scope.bytes();
+  }
+  report(state, allocs, bytes);
+}
+
+struct Observer {
+  void on_event(int v) { benchmark::DoNotOptimize(v); }
+};
+
+template<typename Observers>
+static void BM_AllocNotify(benchmark::State& state) {
+  Observers obs;
+  std::vector<Observer> observers(state.range(0));
+  for (auto& o : observers)
+    obs.add_observer(&o);
+  obs.notify_observers(&Observer::on_event, 0);
+
+  alloc_counter::scope scope;
+  for (auto _ : state)
+    obs.notify_observers(&Observer::on_event, 1);
+  report(state, scope.allocs(), scope.bytes());
+}
+
+BENCHMARK_TEMPLATE(BM_AllocConnect, obs::safe_signal<void(int)>);
+BENCHMARK_TEMPLATE(BM_AllocConnect, obs::fast_signal<void(int)>);
+BENCHMARK_TEMPLATE(BM_AllocEmit, obs::safe_signal<void(int)>)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_AllocEmit, obs::fast_signal<void(int)>)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_AllocDisconnect, obs::safe_signal<void(int)>);
+BENCHMARK_TEMPLATE(BM_AllocDisconnect, obs::fast_signal<void(int)>);
+BENCHMARK_TEMPLATE(BM_AllocNotify, obs::safe_observers<Observer>)->Arg(1)->Arg(64);
+BENCHMARK_TEMPLATE(BM_AllocNotify, obs::fast_observers<Observer>)->Arg(1)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Observable Library
+# Copyright (C) 2026-present David Capello
+#
+# Compares two JSON files generated with
+# "obs_benchmarks --benchmark_out=file.json --benchmark_out_format=json"
+# and returns an error if some benchmark is slower than the baseline
+# by more than the given threshold.
+#
+# Usage: compare.py baseline.json results.json [--threshold=10]
+
+import json
+import sys
+
+UNITS = { 'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9 }
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    results = {}
+    for b in data['benchmarks']:
+        # Skip aggregates (mean/median/stddev) of repetitions except
+        # the median, which is the most stable value.
+        if b.get('run_type') == 'aggregate' and b.get('aggregate_name') != 'median':
+            continue
+        scale = UNITS[b.get('time_unit', 'ns')]
+        entry = { 'time': b['real_time'] * scale }
+        for counter in ('p99', 'emit_p99', 'disconnect_p99', 'notify_p99', 'remove_p99'):
+            if counter in b:
+                entry[counter] = b[counter]
+        results[b['name']] = entry
+    return results
+
+def main(argv):
+    threshold = 10.0
+    files = []
+    for arg in argv[1:]:
+        if arg.startswith('--threshold='):
+            threshold = float(arg.split('=', 1)[1])
+        else:
+            files.append(arg)
+    if len(files) != 2:
+        print(__doc__ or 'Usage: compare.py baseline.json results.json [--threshold=10]')
+        return 2
+
+    base = load(files[0])
+    new = load(files[1])
+    regressions = 0
+
+    print('%-64s %12s %12s %8s' % ('benchmark', 'baseline', 'current', 'diff'))
+    for name in sorted(new):
+        if name not in base:
+            continue
+        for key in sorted(new[name]):
+            if key not in base[name] or base[name][key] == 0:
+                continue
+            a = base[name][key]
+            b = new[name][key]
+            diff = (b - a) * 100.0 / a
+            mark = ''
+            if diff > threshold:
+                mark = ' <- regression'
+                regressions += 1
+            label = name if key == 'time' else name + ' [' + key + ']'
+            print('%-64s %12.1f %12.1f %+7.1f%%%s' % (label, a, b, diff, mark))
+
+    if regressions:
+        print('%d regression(s) above %.1f%%' % (regressions, threshold))
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
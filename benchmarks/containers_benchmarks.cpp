@@ -0,0 +1,116 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Bulk loads in a std::vector that emits one signal per inserted
+// element vs observable_vector<> batched notifications.
+
+#include "obs.h"
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+// A std::vector wrapper that notifies each inserted element.
+struct per_element_vector {
+  std::vector<int> items;
+  obs::signal<void(std::size_t)> inserted;
+
+  void push_back(int v) {
+    items.push_back(v);
+    inserted(items.size()-1);
+  }
+};
+
+static void BM_ContainersPerElementSignal(benchmark::State& state) {
+  const int n = int(state.range(0));
+  std::size_t rows = 0;
+  for (auto _ : state) {
+    per_element_vector v;
+    obs::scoped_connection c =
+      v.inserted.connect([&rows](std::size_t){ ++rows; });
+    for (int i=0; i<n; ++i)
+      v.push_back(i);
+  }
+  benchmark::DoNotOptimize(rows);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ContainersPerElementSignal)->Range(1024, 128<<10);
+
+// One notification per push_back() (like the previous one, but with
+// a diff).
+static void BM_ContainersObservableVector(benchmark::State& state) {
+  const int n = int(state.range(0));
+  std::size_t rows = 0;
+  for (auto _ : state) {
+    obs::observable_vector<int> v;
+    obs::scoped_connection c =
+      v.changed.connect([&rows](const obs::vector_diff& diff) {
+                          for (const auto& ch : diff)
+                            rows += ch.count;
+                        });
+    for (int i=0; i<n; ++i)
+      v.push_back(i);
+  }
+  benchmark::DoNotOptimize(rows);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ContainersObservableVector)->Range(1024, 128<<10);
+
+// All push_back() calls in one transaction (one notification).
+static void BM_ContainersTransaction(benchmark::State& state) {
+  const int n = int(state.range(0));
+  std::size_t rows = 0;
+  for (auto _ : state) {
+    obs::observable_vector<int> v;
+    obs::scoped_connection c =
+      v.changed.connect([&rows](const obs::vector_diff& diff) {
+                          for (const auto& ch : diff)
+                            rows += ch.count;
+                        });
+    obs::observable_vector<int>::transaction t(v);
+    for (int i=0; i<n; ++i)
+      v.push_back(i);
+  }
+  benchmark::DoNotOptimize(rows);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ContainersTransaction)->Range(1024, 128<<10);
+
+// Map: one notification per insertion vs a transaction.
+static void BM_ContainersMapInsert(benchmark::State& state) {
+  const int n = int(state.range(0));
+  std::size_t rows = 0;
+  for (auto _ : state) {
+    obs::observable_map<int, int> m;
+    obs::scoped_connection c =
+      m.changed.connect([&rows](const obs::map_diff<int>& diff) {
+                          rows += diff.inserted.size();
+                        });
+    for (int i=0; i<n; ++i)
+      m.insert(i, i);
+  }
+  benchmark::DoNotOptimize(rows);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ContainersMapInsert)->Range(1024, 128<<10);
+
+static void BM_ContainersMapTransaction(benchmark::State& state) {
+  const int n = int(state.range(0));
+  std::size_t rows = 0;
+  for (auto _ : state) {
+    obs::observable_map<int, int> m;
+    obs::scoped_connection c =
+      m.changed.connect([&rows](const obs::map_diff<int>& diff) {
+                          rows += diff.inserted.size();
+                        });
+    obs::observable_map<int, int>::transaction t(m);
+    for (int i=0; i<n; ++i)
+      m.insert(i, i);
+  }
+  benchmark::DoNotOptimize(rows);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ContainersMapTransaction)->Range(1024, 128<<10);
@@ -0,0 +1,107 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Benchmarks with several threads emitting a signal while other
+// threads connect/disconnect slots to the same signal.
+
+#include "obs.h"
+#include "latency.h"
+
+#include <vector>
+
+struct ContentionObserver {
+  void on_event() { benchmark::ClobberMemory(); }
+};
+
+static obs::safe_signal<void()> g_sig;
+static obs::safe_observers<ContentionObserver> g_observers;
+
+// Half the threads emit the signal and the other half connect and
+// disconnect slots (reported latencies are for each operation).
+static void BM_ContentionEmittersConnectors(benchmark::State& state) {
+  std::vector<obs::scoped_connection> conns;
+  if (state.thread_index() == 0) {
+    conns.resize(state.range(0));
+    for (auto& c : conns)
+      c = g_sig.connect([]{ benchmark::ClobberMemory(); });
+  }
+
+  const bool emitter = ((state.thread_index() % 2) == 0);
+  latency_recorder rec;
+  for (auto _ : state) {
+    if (emitter) {
+      measure(rec, []{ g_sig(); });
+    }
+    else {
+      obs::connection c = g_sig.connect([]{ });
+      measure(rec, [&c]{ c.disconnect(); });
+    }
+  }
+  rec.report(state, emitter ? "emit_": "disconnect_");
+
+  if (state.thread_index() == 0)
+    conns.clear();
+}
+BENCHMARK(BM_ContentionEmittersConnectors)
+  ->Arg(16)->Arg(256)
+  ->ThreadRange(2, 8)
+  ->UseRealTime();
+
+// All threads emit the same signal.
+static void BM_ContentionEmitters(benchmark::State& state) {
+  std::vector<obs::scoped_connection> conns;
+  if (state.thread_index() == 0) {
+    conns.resize(state.range(0));
+    for (auto& c : conns)
+      c = g_sig.connect([]{ benchmark::ClobberMemory(); });
+  }
+
+  latency_recorder rec;
+  for (auto _ : state)
+    measure(rec, []{ g_sig(); });
+  rec.report(state, "emit_");
+
+  if (state.thread_index() == 0)
+    conns.clear();
+}
+BENCHMARK(BM_ContentionEmitters)
+  ->Arg(16)->Arg(256)
+  ->ThreadRange(1, 8)
+  ->UseRealTime();
+
+// Half the threads notify observers, the other half add/remove
+// observers.
+static void BM_ContentionObservers(benchmark::State& state) {
+  std::vector<ContentionObserver> observers;
+  if (state.thread_index() == 0) {
+    observers.resize(state.range(0));
+    for (auto& o : observers)
+      g_observers.add_observer(&o);
+  }
+
+  const bool notifier = ((state.thread_index() % 2) == 0);
+  ContentionObserver extra;
+  latency_recorder rec;
+  for (auto _ : state) {
+    if (notifier) {
+      measure(rec, []{ g_observers.notify_observers(&ContentionObserver::on_event); });
+    }
+    else {
+      g_observers.add_observer(&extra);
+      measure(rec, [&extra]{ g_observers.remove_observer(&extra); });
+    }
+  }
+  rec.report(state, notifier ? "notify_": "remove_");
+
+  if (state.thread_index() == 0) {
+    for (auto& o : observers)
+      g_observers.remove_observer(&o);
+  }
+}
+BENCHMARK(BM_ContentionObservers)
+  ->Arg(16)->Arg(256)
+  ->ThreadRange(2, 8)
+  ->UseRealTime();
@@ -0,0 +1,66 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Cost of recording emissions in a journal, and replaying a recorded
+// journal to benchmark slots with recorded traffic.
+
+#include "obs/journal.h"
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+static std::string journal_path() {
+  return "/tmp/obs_benchmark_" + std::to_string(::getpid()) + ".obsj";
+}
+
+// Emission with a recorder connected (the baseline is the same
+// emission without recorder).
+static void BM_JournalRecord(benchmark::State& state) {
+  const bool recording = (state.range(0) != 0);
+  const std::string path = journal_path();
+  obs::signal<void(int, double)> sig;
+  obs::scoped_connection c = sig.connect([](int, double){ });
+  obs::journal_writer journal(path, std::size_t(1) << 30);
+  obs::scoped_connection r;
+  if (recording)
+    r = journal.record(sig, 1);
+  int i = 0;
+  for (auto _ : state)
+    sig(++i, 2.0);
+  state.counters["dropped"] = double(journal.dropped());
+  journal.close();
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_JournalRecord)->Arg(0)->Arg(1);
+
+// Replays 100k recorded emissions at max speed.
+static void BM_JournalReplay(benchmark::State& state) {
+  const int n = 100000;
+  const std::string path = journal_path();
+  {
+    obs::signal<void(int, double)> sig;
+    obs::journal_writer journal(path);
+    obs::scoped_connection r = journal.record(sig, 1);
+    for (int i=0; i<n; ++i)
+      sig(i, 2.0);
+  }
+
+  obs::signal<void(int, double)> sig;
+  double sum = 0.0;
+  obs::scoped_connection c = sig.connect([&sum](int i, double v){ sum += i*v; });
+  obs::journal_reader reader(path);
+  obs::journal_replayer replayer;
+  replayer.add(1, sig);
+  for (auto _ : state)
+    replayer.replay(reader);
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * n);
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_JournalReplay);
@@ -0,0 +1,60 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Records the latency of each operation in a benchmark to report
+// percentiles (p50/p99/p999 in nanoseconds) as benchmark counters.
+class latency_recorder {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit latency_recorder(std::size_t reserve = 1 << 16) {
+    m_samples.reserve(reserve);
+  }
+
+  void add(clock::time_point start, clock::time_point end) {
+    m_samples.push_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  // Counters are averaged between threads in multi-threaded
+  // benchmarks.
+  void report(benchmark::State& state, const char* prefix = "") {
+    if (m_samples.empty())
+      return;
+    std::sort(m_samples.begin(), m_samples.end());
+    const std::string p(prefix);
+    const auto flags = benchmark::Counter::kAvgThreads;
+    state.counters[p + "p50"] = benchmark::Counter(double(percentile(50.0)), flags);
+    state.counters[p + "p99"] = benchmark::Counter(double(percentile(99.0)), flags);
+    state.counters[p + "p999"] = benchmark::Counter(double(percentile(99.9)), flags);
+    state.counters[p + "max"] = benchmark::Counter(double(m_samples.back()), flags);
+  }
+
+private:
+  std::int64_t percentile(double p) const {
+    std::size_t i = std::size_t(double(m_samples.size()) * p / 100.0);
+    return m_samples[std::min(i, m_samples.size()-1)];
+  }
+
+  std::vector<std::int64_t> m_samples;
+};
+
+// Times the given block of code and adds the latency to the recorder.
+template<typename F>
+inline void measure(latency_recorder& rec, F&& f) {
+  auto t0 = latency_recorder::clock::now();
+  f();
+  rec.add(t0, latency_recorder::clock::now());
+}
@@ -0,0 +1,150 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Benchmarks comparing safe_list vs fast_list (and cow_list) in
+// signals and observers, argument payload sizes, and disconnections in
+// the middle of an emission.
+
+#include "obs.h"
+#include "latency.h"
+
+#include <array>
+#include <vector>
+
+template<typename Signal>
+static void BM_ListsEmit(benchmark::State& state) {
+  Signal sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  for (auto& c : conns)
+    c = sig.connect([]{ });
+  latency_recorder rec;
+  for (auto _ : state)
+    measure(rec, [&sig]{ sig(); });
+  rec.report(state);
+}
+BENCHMARK_TEMPLATE(BM_ListsEmit, obs::safe_signal<void()>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsEmit, obs::fast_signal<void()>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsEmit, obs::cow_signal<void()>)->Range(1, 1024);
+
+template<typename Signal>
+static void BM_ListsConnectDisconnect(benchmark::State& state) {
+  Signal sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  for (auto& c : conns)
+    c = sig.connect([]{ });
+  for (auto _ : state) {
+    obs::connection c = sig.connect([]{ });
+    c.disconnect();
+  }
+}
+BENCHMARK_TEMPLATE(BM_ListsConnectDisconnect, obs::safe_signal<void()>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsConnectDisconnect, obs::fast_signal<void()>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsConnectDisconnect, obs::cow_signal<void()>)->Range(1, 1024);
+
+struct Observer {
+  int count = 0;
+  void on_event() { ++count; }
+  void on_value(int v) { count += v; }
+};
+
+template<typename Observers>
+static void BM_ListsNotifyObservers(benchmark::State& state) {
+  Observers obs;
+  std::vector<Observer> observers(state.range(0));
+  for (auto& o : observers)
+    obs.add_observer(&o);
+  latency_recorder rec;
+  for (auto _ : state)
+    measure(rec, [&obs]{ obs.notify_observers(&Observer::on_value, 1); });
+  rec.report(state);
+  for (auto& o : observers)
+    obs.remove_observer(&o);
+}
+BENCHMARK_TEMPLATE(BM_ListsNotifyObservers, obs::safe_observers<Observer>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsNotifyObservers, obs::fast_observers<Observer>)->Range(1, 1024);
+
+template<typename Observers>
+static void BM_ListsAddRemoveObserver(benchmark::State& state) {
+  Observers obs;
+  std::vector<Observer> observers(state.range(0));
+  for (auto& o : observers)
+    obs.add_observer(&o);
+  Observer extra;
+  for (auto _ : state) {
+    obs.add_observer(&extra);
+    obs.remove_observer(&extra);
+  }
+  for (auto& o : observers)
+    obs.remove_observer(&o);
+}
+BENCHMARK_TEMPLATE(BM_ListsAddRemoveObserver, obs::safe_observers<Observer>)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_ListsAddRemoveObserver, obs::fast_observers<Observer>)->Range(1, 1024);
+
+// Each emission disconnects one slot and connects a new one.
+template<typename Signal>
+static void BM_ListsDisconnectDuringEmit(benchmark::State& state) {
+  Signal sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  for (auto& c : conns)
+    c = sig.connect([]{ });
+
+  // The victim slot has a higher priority so it's always called
+  // before its disconnection (which is required by fast_list).
+  obs::connection victim = sig.connect(1, []{ });
+  obs::scoped_connection churn =
+    sig.connect([&sig, &victim]{
+                  victim.disconnect();
+                  victim = sig.connect(1, []{ });
+                });
+
+  latency_recorder rec;
+  for (auto _ : state)
+    measure(rec, [&sig]{ sig(); });
+  rec.report(state);
+  churn.disconnect();
+  victim.disconnect();
+}
+BENCHMARK_TEMPLATE(BM_ListsDisconnectDuringEmit, obs::safe_signal<void()>)->Range(1, 256);
+BENCHMARK_TEMPLATE(BM_ListsDisconnectDuringEmit, obs::fast_signal<void()>)->Range(1, 256);
+BENCHMARK_TEMPLATE(BM_ListsDisconnectDuringEmit, obs::cow_signal<void()>)->Range(1, 256);
+
+template<std::size_t N>
+struct payload {
+  std::array<char, N> data;
+};
+
+// Arguments passed by const reference...
+template<std::size_t N>
+static void BM_ListsPayloadByRef(benchmark::State& state) {
+  obs::signal<void(const payload<N>&)> sig;
+  std::vector<obs::scoped_connection> conns(8);
+  for (auto& c : conns)
+    c = sig.connect([](const payload<N>& p){ benchmark::DoNotOptimize(p.data[0]); });
+  payload<N> p = {};
+  for (auto _ : state)
+    sig(p);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+// ...vs by value (copied for each slot).
+template<std::size_t N>
+static void BM_ListsPayloadByValue(benchmark::State& state) {
+  obs::signal<void(payload<N>)> sig;
+  std::vector<obs::scoped_connection> conns(8);
+  for (auto& c : conns)
+    c = sig.connect([](payload<N> p){ benchmark::DoNotOptimize(p.data[0]); });
+  payload<N> p = {};
+  for (auto _ : state)
+    sig(p);
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+BENCHMARK_TEMPLATE(BM_ListsPayloadByRef, 8);
+BENCHMARK_TEMPLATE(BM_ListsPayloadByRef, 512);
+BENCHMARK_TEMPLATE(BM_ListsPayloadByRef, 4096);
+BENCHMARK_TEMPLATE(BM_ListsPayloadByValue, 8);
+BENCHMARK_TEMPLATE(BM_ListsPayloadByValue, 512);
+BENCHMARK_TEMPLATE(BM_ListsPayloadByValue, 4096);
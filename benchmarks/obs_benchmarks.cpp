@@ -9,7 +9,11 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <future>
+#include <limits>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -42,6 +46,20 @@ static void BM_ObsDisconnect(benchmark::State& state) {
 }
 BENCHMARK(BM_ObsDisconnect);
 
+// Disconnection of a handle whose slot was already disconnected (it's
+// just a lookup in the slot table).
+static void BM_ObsLateDisconnect(benchmark::State& state) {
+  obs::signal<void()> sig;
+  obs::connection stale = sig.connect([]{ });
+  obs::connection(stale).disconnect();
+  for (auto _ : state) {
+    obs::connection c = stale;
+    benchmark::DoNotOptimize(c);
+    c.disconnect();
+  }
+}
+BENCHMARK(BM_ObsLateDisconnect);
+
 static void BM_ObsSignal(benchmark::State& state) {
   obs::signal<void()> sig;
   std::vector<obs::scoped_connection> conns(state.range(0));
@@ -53,6 +71,74 @@ static void BM_ObsSignal(benchmark::State& state) {
 }
 BENCHMARK(BM_ObsSignal)->Range(1, 1024);
 
+// Slots with the exact signature of the signal...
+static void BM_ObsExactArgsSlots(benchmark::State& state) {
+  obs::signal<void(int, const std::string&, double)> sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  for (auto& c : conns)
+    c = sig.connect([](int v, const std::string&, double){ benchmark::DoNotOptimize(v); });
+  const std::string s = "text";
+  for (auto _ : state)
+    sig(1, s, 2.0);
+}
+BENCHMARK(BM_ObsExactArgsSlots)->Range(1, 1024);
+
+// ...vs slots that receive only the first argument.
+static void BM_ObsPrefixArgsSlots(benchmark::State& state) {
+  obs::signal<void(int, const std::string&, double)> sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  for (auto& c : conns)
+    c = sig.connect([](int v){ benchmark::DoNotOptimize(v); });
+  const std::string s = "text";
+  for (auto _ : state)
+    sig(1, s, 2.0);
+}
+BENCHMARK(BM_ObsPrefixArgsSlots)->Range(1, 1024);
+
+// Emission where all slots are blocked, to compare the cost of
+// checking the block flag against BM_ObsSignal.
+static void BM_ObsSignalBlocked(benchmark::State& state) {
+  obs::signal<void()> sig;
+  std::vector<obs::scoped_connection> conns(state.range(0));
+  std::vector<std::unique_ptr<obs::shared_connection_block>> blocks;
+  for (auto& c : conns) {
+    obs::connection conn = sig.connect([]{ });
+    blocks.emplace_back(new obs::shared_connection_block(conn));
+    c = conn;
+  }
+  for (auto _ : state) {
+    sig();
+  }
+}
+BENCHMARK(BM_ObsSignalBlocked)->Range(1, 1024);
+
+// Muting a slot around an update with block/unblock...
+static void BM_ObsBlockUnblock(benchmark::State& state) {
+  obs::signal<void()> sig;
+  obs::scoped_connection c = sig.connect([]{ });
+  obs::connection conn = sig.connect([]{ });
+  for (auto _ : state) {
+    obs::shared_connection_block block(conn);
+    sig();
+  }
+  conn.disconnect();
+}
+BENCHMARK(BM_ObsBlockUnblock);
+
+// ...vs disconnecting/reconnecting it.
+static void BM_ObsDisconnectReconnect(benchmark::State& state) {
+  obs::signal<void()> sig;
+  obs::scoped_connection c = sig.connect([]{ });
+  obs::connection conn = sig.connect([]{ });
+  for (auto _ : state) {
+    conn.disconnect();
+    sig();
+    conn = sig.connect([]{ });
+  }
+  conn.disconnect();
+}
+BENCHMARK(BM_ObsDisconnectReconnect);
+
 static void BM_ObsThreads(benchmark::State& state) {
   obs::safe_signal<void()> sig;
   for (auto _ : state) {
@@ -91,4 +177,171 @@ static void BM_ObsThreads(benchmark::State& state) {
 }
 BENCHMARK(BM_ObsThreads)->Range(1, 1024);
 
+// Four stages (filter, map, map, sink) fused in just one slot.
+static void BM_ObsFusedPipeline(benchmark::State& state) {
+  obs::signal<void(int)> sig;
+  int result = 0;
+  obs::scoped_connection c =
+    (obs::from(sig)
+     | obs::filter([](int x){ return x >= 0; })
+     | obs::map([](int x){ return x * 2; })
+     | obs::map([](int x){ return x + 1; }))
+    .connect([&result](int x){ result += x; });
+  int i = 0;
+  for (auto _ : state)
+    sig(++i);
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(BM_ObsFusedPipeline);
+
+// The same four stages chained by hand with intermediate signals.
+static void BM_ObsChainedSignals(benchmark::State& state) {
+  obs::signal<void(int)> sig, filtered, mapped1, mapped2;
+  int result = 0;
+  obs::scoped_connection c1 =
+    sig.connect([&filtered](int x){ if (x >= 0) filtered(x); });
+  obs::scoped_connection c2 =
+    filtered.connect([&mapped1](int x){ mapped1(x * 2); });
+  obs::scoped_connection c3 =
+    mapped1.connect([&mapped2](int x){ mapped2(x + 1); });
+  obs::scoped_connection c4 =
+    mapped2.connect([&result](int x){ result += x; });
+  int i = 0;
+  for (auto _ : state)
+    sig(++i);
+  benchmark::DoNotOptimize(result);
+}
+BENCHMARK(BM_ObsChainedSignals);
+
+// Teardown of N receivers disconnected one by one with
+// scoped_connection.
+static void BM_ObsScopedTeardown(benchmark::State& state) {
+  obs::signal<void()> sig;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<obs::scoped_connection> conns(state.range(0));
+    for (auto& c : conns)
+      c = sig.connect([]{ });
+    state.ResumeTiming();
+    conns.clear();
+  }
+}
+BENCHMARK(BM_ObsScopedTeardown)->Range(256, 4096);
+
+// Teardown of N tracked receivers, expired slots are deleted in bulk
+// in the next emission.
+static void BM_ObsTrackedTeardown(benchmark::State& state) {
+  obs::signal<void()> sig;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<std::shared_ptr<int>> receivers(state.range(0));
+    for (auto& r : receivers) {
+      r = std::make_shared<int>(0);
+      sig.connect(r, []{ });
+    }
+    state.ResumeTiming();
+    receivers.clear();
+    sig();
+  }
+}
+BENCHMARK(BM_ObsTrackedTeardown)->Range(256, 4096);
+
+// Mass teardown of a view with 200 connections to 20 signals,
+// disconnecting each scoped_connection one by one.
+static void BM_ObsViewTeardownScoped(benchmark::State& state) {
+  std::vector<obs::signal<void()>> sigs(20);
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<obs::scoped_connection> conns(200);
+    for (std::size_t i=0; i<conns.size(); ++i)
+      conns[i] = sigs[i % sigs.size()].connect([]{ });
+    state.ResumeTiming();
+    conns.clear();
+  }
+}
+BENCHMARK(BM_ObsViewTeardownScoped);
+
+// The same teardown with a connection_group (each signal is locked
+// and compacted once).
+static void BM_ObsViewTeardownGroup(benchmark::State& state) {
+  std::vector<obs::signal<void()>> sigs(20);
+  for (auto _ : state) {
+    state.PauseTiming();
+    {
+      obs::connection_group group;
+      for (std::size_t i=0; i<200; ++i)
+        group += sigs[i % sigs.size()].connect([]{ });
+      state.ResumeTiming();
+    }
+  }
+}
+BENCHMARK(BM_ObsViewTeardownGroup);
+
+// A cascade of nested emissions of the same signal (recursive vs
+// deferred to the outermost emission).
+static void cascade(benchmark::State& state, obs::reentrancy mode) {
+  obs::safe_signal<void(int)> sig;
+  sig.set_reentrancy(mode, std::numeric_limits<int>::max());
+  obs::scoped_connection a = sig.connect([&sig](int i){
+                                           if (i > 0)
+                                             sig(i-1);
+                                         });
+  obs::scoped_connection b = sig.connect([](int){ });
+  for (auto _ : state)
+    sig(int(state.range(0)));
+}
+
+static void BM_ObsCascadeRecursive(benchmark::State& state) {
+  cascade(state, obs::reentrancy::allow);
+}
+BENCHMARK(BM_ObsCascadeRecursive)->Range(8, 512);
+
+static void BM_ObsCascadeDeferred(benchmark::State& state) {
+  cascade(state, obs::reentrancy::defer);
+}
+BENCHMARK(BM_ObsCascadeDeferred)->Range(8, 512);
+
+// Nested emissions of the same signal (from its last slot) with
+// several slots, so each level of the recursion locks all nodes
+// from the same thread where they were connected.
+static void BM_ObsNestedEmitDepth(benchmark::State& state) {
+  obs::safe_signal<void(int)> sig;
+  std::vector<obs::scoped_connection> conns(16);
+  for (std::size_t i=0; i<conns.size()-1; ++i)
+    conns[i] = sig.connect([](int v){ benchmark::DoNotOptimize(v); });
+  conns.back() = sig.connect([&sig](int i){
+                               if (i > 0)
+                                 sig(i-1);
+                             });
+  for (auto _ : state)
+    sig(int(state.range(0)));
+}
+BENCHMARK(BM_ObsNestedEmitDepth)->Arg(1)->Arg(16)->Arg(256);
+
+// Creating clones of a prototype object with N slots connected:
+// reconnecting all the slots to each clone...
+static void BM_ObsCloneReconnect(benchmark::State& state) {
+  std::vector<std::function<void(int)>> slots(state.range(0),
+                                              [](int v){ benchmark::DoNotOptimize(v); });
+  for (auto _ : state) {
+    obs::fast_signal<void(int)> clone;
+    for (const auto& f : slots)
+      clone.connect(f);
+    clone(1);
+  }
+}
+BENCHMARK(BM_ObsCloneReconnect)->Range(8, 512);
+
+// ...vs copying a cow_signal (which shares the slots).
+static void BM_ObsCloneShared(benchmark::State& state) {
+  obs::cow_signal<void(int)> proto;
+  for (int i=0; i<state.range(0); ++i)
+    proto.connect([](int v){ benchmark::DoNotOptimize(v); });
+  for (auto _ : state) {
+    obs::cow_signal<void(int)> clone = proto;
+    clone(1);
+  }
+}
+BENCHMARK(BM_ObsCloneShared)->Range(8, 512);
+
 BENCHMARK_MAIN();
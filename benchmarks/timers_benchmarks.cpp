@@ -0,0 +1,77 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Scheduling and cancelling timers in a timer_wheel vs an ordered
+// timer queue (O(log n) per operation).
+
+#include "obs/timer_signal.h"
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+using ms = std::chrono::milliseconds;
+
+// Pseudo-random delays between 1ms and ~1 hour.
+static std::vector<std::uint32_t> make_delays(std::size_t n) {
+  std::vector<std::uint32_t> delays(n);
+  std::uint32_t x = 12345;
+  for (auto& d : delays) {
+    x = x*1103515245 + 12345;
+    d = 1 + (x >> 8) % 3600000;
+  }
+  return delays;
+}
+
+static void BM_TimersWheelScheduleCancel(benchmark::State& state) {
+  const auto delays = make_delays(std::size_t(state.range(0)));
+  std::vector<obs::connection> conns(delays.size());
+  obs::timer_wheel wheel(ms(1));
+  for (auto _ : state) {
+    for (std::size_t i=0; i<delays.size(); ++i)
+      conns[i] = wheel.connect_after(ms(delays[i]), []{ });
+    for (auto& c : conns)
+      c.disconnect();
+  }
+  state.SetItemsProcessed(state.iterations() * delays.size());
+}
+BENCHMARK(BM_TimersWheelScheduleCancel)->Arg(1000)->Arg(1000000)
+  ->Unit(benchmark::kMillisecond);
+
+// Timer queue ordered by expiration time.
+static void BM_TimersQueueScheduleCancel(benchmark::State& state) {
+  using queue = std::multimap<std::uint64_t, std::function<void()>>;
+  const auto delays = make_delays(std::size_t(state.range(0)));
+  std::vector<queue::iterator> timers(delays.size());
+  queue q;
+  for (auto _ : state) {
+    for (std::size_t i=0; i<delays.size(); ++i)
+      timers[i] = q.emplace(delays[i], []{ });
+    for (auto& t : timers)
+      q.erase(t);
+  }
+  state.SetItemsProcessed(state.iterations() * delays.size());
+}
+BENCHMARK(BM_TimersQueueScheduleCancel)->Arg(1000)->Arg(1000000)
+  ->Unit(benchmark::kMillisecond);
+
+// Advancing the wheel with 100k pending timers (each tick calls the
+// expired timers and moves the ones in the upper levels).
+static void BM_TimersWheelAdvance(benchmark::State& state) {
+  const auto delays = make_delays(100000);
+  obs::timer_wheel wheel(ms(1));
+  obs::connection_group conns;
+  std::uint64_t calls = 0;
+  for (auto d : delays)
+    conns.add(wheel.connect_every(ms(d), [&calls]{ ++calls; }));
+  for (auto _ : state)
+    wheel.advance_ticks(1);
+  benchmark::DoNotOptimize(calls);
+}
+BENCHMARK(BM_TimersWheelAdvance);
@@ -10,7 +10,10 @@
 
 #include "obs/lists.h"
 #include "obs/observable.h"
+#include "obs/observable_map.h"
+#include "obs/observable_vector.h"
 #include "obs/observers.h"
+#include "obs/operators.h"
 #include "obs/signal.h"
 #include "obs/slot.h"
 
@@ -7,20 +7,258 @@
 #include "obs/connection.h"
 #include "obs/signal.h"
 
+#include <atomic>
 #include <cassert>
+#include <mutex>
+#include <new>
 
 namespace obs {
 
+namespace {
+
+// The table is a fixed array of chunks which are allocated on demand
+// (and never freed), so entries don't move when the table grows.
+const std::uint32_t kChunkBits = 12;
+const std::uint32_t kChunkSize = (1 << kChunkBits);
+const std::uint32_t kMaxChunks = 4096;
+
+struct entry {
+  std::atomic<std::uint32_t> generation { 0 };
+  std::atomic<signal_base*> signal { nullptr };
+  std::atomic<slot_base*> slot { nullptr };
+  std::atomic<std::uint32_t> next_free { 0 };
+};
+
+std::atomic<entry*> g_chunks[kMaxChunks];
+std::mutex g_chunks_mutex;
+
+// Index 0 is never used (it's the index of empty handles).
+std::atomic<std::uint32_t> g_next_index { 1 };
+
+// Head of the list of free entries, the high 32 bits are a counter
+// incremented in each change to avoid the ABA problem.
+std::atomic<std::uint64_t> g_free { 0 };
+
+entry* find_entry(std::uint32_t index) {
+  const std::uint32_t c = (index >> kChunkBits);
+  if (c >= kMaxChunks)
+    return nullptr;
+  entry* chunk = g_chunks[c].load(std::memory_order_acquire);
+  return (chunk ? chunk + (index & (kChunkSize-1)): nullptr);
+}
+
+// Entry of an index returned by slot_table::add()
+entry& get_entry(std::uint32_t index) {
+  return g_chunks[index >> kChunkBits].load(std::memory_order_acquire)
+    [index & (kChunkSize-1)];
+}
+
+std::uint64_t make_head(std::uint64_t prev, std::uint32_t index) {
+  return (((prev >> 32) + 1) << 32) | index;
+}
+
+void push_free(std::uint32_t index) {
+  entry& e = get_entry(index);
+  std::uint64_t head = g_free.load(std::memory_order_relaxed);
+  do {
+    e.next_free.store(std::uint32_t(head), std::memory_order_relaxed);
+  } while (!g_free.compare_exchange_weak(head, make_head(head, index),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+std::uint32_t pop_free() {
+  std::uint64_t head = g_free.load(std::memory_order_acquire);
+  for (;;) {
+    const std::uint32_t index = std::uint32_t(head);
+    if (!index)
+      return 0;
+
+    const std::uint32_t next =
+      get_entry(index).next_free.load(std::memory_order_relaxed);
+    if (g_free.compare_exchange_weak(head, make_head(head, next),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire))
+      return index;
+  }
+}
+
+// Each thread keeps some free entries to connect/disconnect slots
+// without touching the shared list. It's trivially destructible so it
+// can be used even after the thread_local objects were destroyed
+// (e.g. when static signals are destroyed at exit).
+const int kLocalFreeSize = 32;
+
+struct local_free_list {
+  std::uint32_t items[kLocalFreeSize];
+  int size;
+  bool registered;  // The flusher was created for this thread
+  bool disabled;    // The thread is finishing
+};
+
+thread_local local_free_list t_free;
+
+// Returns the entries of the thread to the shared list when the
+// thread finishes.
+struct local_free_list_flusher {
+  ~local_free_list_flusher() {
+    t_free.disabled = true;
+    while (t_free.size > 0)
+      push_free(t_free.items[--t_free.size]);
+  }
+};
+
+} // anonymous namespace
+
+std::uint32_t slot_table::add(signal_base* sig, slot_base* slot,
+                              std::uint32_t& generation) {
+  local_free_list& local = t_free;
+  std::uint32_t index = (local.size > 0 ? local.items[--local.size]:
+                                          pop_free());
+
+  // New entry
+  if (!index) {
+    index = g_next_index.fetch_add(1, std::memory_order_relaxed);
+    const std::uint32_t c = (index >> kChunkBits);
+    if (c >= kMaxChunks)
+      throw std::bad_alloc();
+
+    if (!g_chunks[c].load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(g_chunks_mutex);
+      if (!g_chunks[c].load(std::memory_order_relaxed))
+        g_chunks[c].store(new entry[kChunkSize], std::memory_order_release);
+    }
+  }
+
+  entry& e = get_entry(index);
+  e.signal.store(sig, std::memory_order_relaxed);
+  e.slot.store(slot, std::memory_order_relaxed);
+  generation = e.generation.load(std::memory_order_relaxed);
+  return index;
+}
+
+void slot_table::remove(std::uint32_t index) {
+  entry& e = get_entry(index);
+
+  // Only the slot destructor changes the generation of its entry
+  e.generation.store(e.generation.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+  e.signal.store(nullptr, std::memory_order_relaxed);
+  e.slot.store(nullptr, std::memory_order_relaxed);
+
+  local_free_list& local = t_free;
+  if (!local.disabled && local.size < kLocalFreeSize) {
+    if (!local.registered) {
+      static thread_local local_free_list_flusher flusher;
+      (void)flusher;
+      local.registered = true;
+    }
+    local.items[local.size++] = index;
+  }
+  else
+    push_free(index);
+}
+
+bool slot_table::get(std::uint32_t index, std::uint32_t generation,
+                     signal_base*& sig, slot_base*& slot) {
+  if (!index)
+    return false;
+
+  entry* e = find_entry(index);
+  if (!e || e->generation.load(std::memory_order_acquire) != generation)
+    return false;
+
+  sig = e->signal.load(std::memory_order_relaxed);
+  slot = e->slot.load(std::memory_order_relaxed);
+
+  // Check again in case that the entry was reused in the meantime
+  return (sig && slot &&
+          e->generation.load(std::memory_order_acquire) == generation);
+}
+
+signal_base* slot_table::signal_of(std::uint32_t index) {
+  if (!index)
+    return nullptr;
+  return get_entry(index).signal.load(std::memory_order_relaxed);
+}
+
+connection::connection(signal_base* sig,
+                       slot_base* slot) {
+  m_index = slot_table::add(sig, slot, m_generation);
+  slot->set_handle(m_index);
+}
+
 void connection::disconnect() {
-  if (!m_slot)
+  signal_base* sig;
+  slot_base* slot;
+  if (slot_table::get(m_index, m_generation, sig, slot)) {
+    sig->disconnect_slot(slot);
+
+    // The slot can still be referenced by other signals (see
+    // obs::cow_list), so we invalidate all the handles to it here.
+    slot->reset_handle();
+    slot->release();
+  }
+  m_index = 0;
+}
+
+void connection::block() {
+  signal_base* sig;
+  slot_base* slot;
+  if (slot_table::get(m_index, m_generation, sig, slot))
+    slot->block();
+}
+
+void connection::unblock() {
+  signal_base* sig;
+  slot_base* slot;
+  if (slot_table::get(m_index, m_generation, sig, slot))
+    slot->unblock();
+}
+
+bool connection::blocked() const {
+  signal_base* sig;
+  slot_base* slot;
+  return (slot_table::get(m_index, m_generation, sig, slot) &&
+          slot->blocked());
+}
+
+bool connection::connected() const {
+  signal_base* sig;
+  slot_base* slot;
+  return slot_table::get(m_index, m_generation, sig, slot);
+}
+
+void connection_group::disconnect() {
+  if (m_conns.empty())
     return;
 
-  assert(m_signal);
-  if (m_signal)
-    m_signal->disconnect_slot(m_slot);
+  signal_base* sig;
+  slot_base* slot;
+
+  // Connections that were already disconnected are skipped
+  for (auto& conn : m_conns) {
+    if (slot_table::get(conn.m_index, conn.m_generation, sig, slot))
+      slot->set_pending_disconnect(true);
+  }
+
+  // Each signal removes all its pending slots in just one pass, so
+  // the following connections to the same signal are skipped.
+  for (auto& conn : m_conns) {
+    if (slot_table::get(conn.m_index, conn.m_generation, sig, slot) &&
+        slot->pending_disconnect()) {
+      sig->disconnect_pending_slots();
+    }
+  }
+
+  for (auto& conn : m_conns) {
+    if (slot_table::get(conn.m_index, conn.m_generation, sig, slot)) {
+      slot->reset_handle();
+      slot->release();
+    }
+  }
 
-  delete m_slot;
-  m_slot = nullptr;
+  m_conns.clear();
 }
 
 } // namespace obs
@@ -8,30 +8,70 @@
 #define OBS_CONNETION_H_INCLUDED
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace obs {
 
 class signal_base;
 class slot_base;
 
+// Table of connected slots indexed by connection handles. Entries
+// are never moved or freed, and each one has a generation that is
+// incremented when its slot is destroyed, so a handle to a destroyed
+// slot (or to a reused entry) is detected without touching the slot.
+class slot_table {
+public:
+  // Registers the slot of the given signal, returns the index of its
+  // entry (always > 0) and its current generation.
+  static std::uint32_t add(signal_base* sig, slot_base* slot,
+                           std::uint32_t& generation);
+
+  // Invalidates the handles to the given entry and reuses it later.
+  static void remove(std::uint32_t index);
+
+  // Returns true and the signal/slot of the given handle if the slot
+  // wasn't destroyed yet.
+  static bool get(std::uint32_t index, std::uint32_t generation,
+                  signal_base*& sig, slot_base*& slot);
+
+  // Returns the signal of the given entry (nullptr if index == 0).
+  static signal_base* signal_of(std::uint32_t index);
+};
+
+// A handle to a connected slot. It's just an index in the slot table
+// and a generation, so it can be copied freely, and it's safe to
+// disconnect/block it (it does nothing) after the slot was
+// disconnected or the signal was destroyed.
 class connection {
 public:
-  connection() : m_signal(nullptr),
-                 m_slot(nullptr) {
+  connection() : m_index(0),
+                 m_generation(0) {
   }
 
   connection(signal_base* sig,
-             slot_base* slot) :
-    m_signal(sig),
-    m_slot(slot) {
-  }
+             slot_base* slot);
 
   void disconnect();
 
-  operator bool() const { return (m_slot != nullptr); }
+  // Blocks/unblocks the slot without disconnecting it. A blocked slot
+  // is not called by the signal (the block takes effect immediately,
+  // even for emissions that are running in other threads).
+  void block();
+  void unblock();
+  bool blocked() const;
+
+  // True if the slot is still connected.
+  bool connected() const;
+
+  operator bool() const { return connected(); }
 
 private:
-  signal_base* m_signal;
-  slot_base* m_slot;
+  friend class connection_group;
+
+  std::uint32_t m_index;
+  std::uint32_t m_generation;
 };
 
 class scoped_connection {
@@ -62,6 +102,85 @@ private:
   connection m_conn;
 };
 
+// Blocks a connection in the scope of this object (e.g. to avoid
+// feedback loops while we update some state).
+class shared_connection_block {
+public:
+  explicit shared_connection_block(const connection& conn,
+                                   bool initially_blocking = true)
+    : m_conn(conn) {
+    if (initially_blocking)
+      block();
+  }
+
+  ~shared_connection_block() {
+    unblock();
+  }
+
+  shared_connection_block(const shared_connection_block&) = delete;
+  shared_connection_block& operator=(const shared_connection_block&) = delete;
+
+  void block() {
+    if (!m_blocking) {
+      m_conn.block();
+      m_blocking = true;
+    }
+  }
+
+  void unblock() {
+    if (m_blocking) {
+      m_conn.unblock();
+      m_blocking = false;
+    }
+  }
+
+  bool blocking() const { return m_blocking; }
+
+private:
+  connection m_conn;
+  bool m_blocking = false;
+};
+
+// Keeps a set of connections to disconnect all of them at once (e.g.
+// when a view with several connections to different signals is
+// destroyed). Connections are grouped by signal, so each signal's
+// list is locked and compacted just once.
+class connection_group {
+public:
+  connection_group() {
+  }
+
+  ~connection_group() {
+    disconnect();
+  }
+
+  connection_group(const connection_group&) = delete;
+  connection_group& operator=(const connection_group&) = delete;
+
+  bool empty() const { return m_conns.empty(); }
+  std::size_t size() const { return m_conns.size(); }
+
+  void add(const connection& conn) {
+    if (conn)
+      m_conns.push_back(conn);
+  }
+
+  void add(const std::vector<connection>& conns) {
+    for (const auto& conn : conns)
+      add(conn);
+  }
+
+  connection_group& operator+=(const connection& conn) {
+    add(conn);
+    return *this;
+  }
+
+  void disconnect();
+
+private:
+  std::vector<connection> m_conns;
+};
+
 } // namespace obs
 
 #endif
@@ -0,0 +1,249 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_COW_LIST_H_INCLUDED
+#define OBS_COW_LIST_H_INCLUDED
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace obs {
+
+// A list whose copies share the same table of values until one of
+// them is modified (copy-on-write), so copying a list is O(1). Values
+// are reference counted (T must have add_ref() and release() member
+// functions like obs::slot_base), each table keeps one reference of
+// each value.
+//
+// Like fast_list<> it cannot be modified from several threads at the
+// same time, but different copies can be used in different threads.
+template<typename T>
+class cow_list {
+  struct table {
+    std::atomic<int> refs = { 1 };
+    std::vector<T*> items;
+
+    ~table() {
+      for (T* value : items)
+        value->release();
+    }
+  };
+
+  // Table of this list (nullptr if the list is empty and was never
+  // modified).
+  table* m_table = nullptr;
+
+  // Number of snapshots in progress, while it's > 0 the table cannot
+  // be modified in place.
+  int m_iterating = 0;
+
+  // Tables replaced while they were being iterated, they are released
+  // when the last snapshot finishes.
+  std::vector<table*> m_retired;
+
+public:
+  using iterator = T**;
+
+  // Iterates the current table of the list. The table is not
+  // modified while it's iterated (modifications are done in a new
+  // table), so it doesn't need to copy the list. Values erased from
+  // the list after the snapshot started are returned as nullptr (as
+  // in safe_list<>).
+  class snapshot {
+  public:
+    class iterator {
+    public:
+      iterator(const snapshot* snap, T** it)
+        : m_snap(snap), m_it(it) { }
+
+      iterator& operator++() { ++m_it; return *this; }
+      bool operator!=(const iterator& other) const { return m_it != other.m_it; }
+      bool operator==(const iterator& other) const { return m_it == other.m_it; }
+
+      T* operator*() const {
+        return (m_snap->contains(*m_it) ? *m_it: nullptr);
+      }
+
+    private:
+      const snapshot* m_snap;
+      T** m_it;
+    };
+
+    explicit snapshot(cow_list& list)
+      : m_list(&list),
+        m_table(list.m_table) {
+      ++list.m_iterating;
+    }
+
+    snapshot(snapshot&& other)
+      : m_list(other.m_list),
+        m_table(other.m_table) {
+      other.m_list = nullptr;
+    }
+
+    snapshot(const snapshot&) = delete;
+    snapshot& operator=(const snapshot&) = delete;
+
+    ~snapshot() {
+      if (m_list && --m_list->m_iterating == 0)
+        m_list->release_retired();
+    }
+
+    iterator begin() { return iterator(this, m_table ? m_table->items.data(): nullptr); }
+    iterator end() { return iterator(this, m_table ? m_table->items.data() + m_table->items.size(): nullptr); }
+
+  private:
+    // The value is still in the list if the table wasn't replaced
+    // (the snapshot table keeps a reference to the value anyway).
+    bool contains(T* value) const {
+      const table* current = m_list->m_table;
+      if (current == m_table)
+        return true;
+      return (current &&
+              std::find(current->items.begin(),
+                        current->items.end(), value) != current->items.end());
+    }
+
+    cow_list* m_list;
+    table* m_table;
+  };
+
+  cow_list() = default;
+
+  ~cow_list() {
+    release_retired();
+    unref(m_table);
+  }
+
+  // The copy shares the table of the other list.
+  cow_list(const cow_list& other) : m_table(ref(other.m_table)) { }
+  cow_list& operator=(const cow_list& other) {
+    replace_table(ref(other.m_table));
+    return *this;
+  }
+
+  // True if this list shares its table with other copies.
+  bool shared() const {
+    return (m_table && m_table->refs.load(std::memory_order_acquire) > 1);
+  }
+
+  bool empty() const { return (!m_table || m_table->items.empty()); }
+  iterator begin() { return (m_table ? m_table->items.data(): nullptr); }
+  iterator end() { return (m_table ? m_table->items.data() + m_table->items.size(): nullptr); }
+
+  // The list takes the reference of the new value.
+  void push_back(T* value) {
+    make_unique();
+    m_table->items.push_back(value);
+  }
+
+  // Inserts the value before the first element "e" where
+  // less(value, e) is true, or at the end of the list.
+  template<typename Less>
+  void insert(T* value, Less less) {
+    make_unique();
+    std::vector<T*>& items = m_table->items;
+    if (items.empty() || !less(value, items.back()))
+      items.push_back(value);
+    else
+      items.insert(std::upper_bound(items.begin(), items.end(), value, less),
+                   value);
+  }
+
+  // Removes the value from the list, the reference of the list to
+  // the value is given to the caller (which must release it).
+  void erase(T* value) {
+    if (!m_table ||
+        std::find(m_table->items.begin(),
+                  m_table->items.end(), value) == m_table->items.end())
+      return;
+
+    make_unique();
+    std::vector<T*>& items = m_table->items;
+    items.erase(std::find(items.begin(), items.end(), value));
+  }
+
+  // Erases all values that match the given predicate with just one
+  // pass (the caller must release the erased values).
+  template<typename Pred>
+  void erase_if(Pred pred) {
+    if (!m_table)
+      return;
+    make_unique();
+    std::vector<T*>& items = m_table->items;
+    items.erase(std::remove_if(items.begin(), items.end(), pred),
+                items.end());
+  }
+
+  // Erases and releases all values that match the given predicate.
+  template<typename Pred>
+  void dispose_if(Pred pred) {
+    if (!m_table)
+      return;
+    make_unique();
+    std::vector<T*>& items = m_table->items;
+    auto it = std::remove_if(items.begin(), items.end(),
+                             [&pred](T* value) {
+                               if (!pred(value))
+                                 return false;
+                               value->release();
+                               return true;
+                             });
+    items.erase(it, items.end());
+  }
+
+private:
+  static table* ref(table* t) {
+    if (t)
+      t->refs.fetch_add(1, std::memory_order_relaxed);
+    return t;
+  }
+
+  static void unref(table* t) {
+    if (t &&
+        (t->refs.load(std::memory_order_acquire) == 1 ||
+         t->refs.fetch_sub(1, std::memory_order_acq_rel) == 1))
+      delete t;
+  }
+
+  // Makes sure that m_table can be modified in place (it's not
+  // shared with other lists and it's not being iterated).
+  void make_unique() {
+    if (!m_table) {
+      m_table = new table;
+      return;
+    }
+    if (m_iterating == 0 &&
+        m_table->refs.load(std::memory_order_acquire) == 1)
+      return;
+
+    table* t = new table;
+    t->items = m_table->items;
+    for (T* value : t->items)
+      value->add_ref();
+    replace_table(t);
+  }
+
+  void replace_table(table* t) {
+    if (m_iterating > 0 && m_table)
+      m_retired.push_back(m_table);
+    else
+      unref(m_table);
+    m_table = t;
+  }
+
+  void release_retired() {
+    for (table* t : m_retired)
+      unref(t);
+    m_retired.clear();
+  }
+};
+
+} // namespace obs
+
+#endif
@@ -18,12 +18,67 @@ template<typename T>
 class fast_list {
   std::vector<T*> m_list;
 
+  // Buffer reused by the first snapshot() so iterating the list
+  // doesn't allocate memory (only nested iterations, e.g. recursive
+  // emissions, need a new buffer).
+  std::vector<T*> m_spare;
+  bool m_spare_in_use = false;
+
 public:
   using iterator = typename std::vector<T*>::iterator;
 
+  // A copy of the list used to iterate it while the original list
+  // can be modified (e.g. to disconnect a slot from the same signal
+  // in the middle of an emission).
+  class snapshot {
+  public:
+    explicit snapshot(fast_list& list)
+      : m_list(&list),
+        m_borrowed(!list.m_spare_in_use) {
+      if (m_borrowed) {
+        m_items.swap(list.m_spare);
+        list.m_spare_in_use = true;
+      }
+      m_items.assign(list.m_list.begin(), list.m_list.end());
+    }
+
+    snapshot(snapshot&& other)
+      : m_list(other.m_list),
+        m_items(std::move(other.m_items)),
+        m_borrowed(other.m_borrowed) {
+      other.m_borrowed = false;
+    }
+
+    snapshot(const snapshot&) = delete;
+    snapshot& operator=(const snapshot&) = delete;
+
+    ~snapshot() {
+      if (m_borrowed) {
+        m_items.clear();
+        m_items.swap(m_list->m_spare);
+        m_list->m_spare_in_use = false;
+      }
+    }
+
+    iterator begin() { return m_items.begin(); }
+    iterator end() { return m_items.end(); }
+
+  private:
+    fast_list* m_list;
+    std::vector<T*> m_items;
+    bool m_borrowed;
+  };
+
   fast_list() = default;
   ~fast_list() = default;
 
+  // The spare buffer is not copied.
+  fast_list(const fast_list& other) : m_list(other.m_list) { }
+  fast_list& operator=(const fast_list& other) {
+    m_list = other.m_list;
+    return *this;
+  }
+
   bool empty() const { return m_list.empty(); }
   iterator begin() { return m_list.begin(); }
   iterator end() { return m_list.end(); }
@@ -32,11 +87,44 @@ public:
     m_list.push_back(value);
   }
 
+  // Inserts the value before the first element "e" where
+  // less(value, e) is true, or at the end of the list.
+  template<typename Less>
+  void insert(T* value, Less less) {
+    if (m_list.empty() || !less(value, m_list.back()))
+      m_list.push_back(value);
+    else
+      m_list.insert(std::upper_bound(m_list.begin(), m_list.end(), value, less),
+                    value);
+  }
+
   void erase(T* value) {
     auto it = std::find(m_list.begin(), m_list.end(), value);
     if (it != m_list.end())
       m_list.erase(it);
   }
+
+  // Erases all values that match the given predicate with just one
+  // pass.
+  template<typename Pred>
+  void erase_if(Pred pred) {
+    m_list.erase(std::remove_if(m_list.begin(), m_list.end(), pred),
+                 m_list.end());
+  }
+
+  // Erases and releases all values that match the given predicate
+  // (values must be reference counted, e.g. slots).
+  template<typename Pred>
+  void dispose_if(Pred pred) {
+    auto it = std::remove_if(m_list.begin(), m_list.end(),
+                             [&pred](T* value) {
+                               if (!pred(value))
+                                 return false;
+                               value->release();
+                               return true;
+                             });
+    m_list.erase(it, m_list.end());
+  }
 };
 
 } // namespace obs
@@ -0,0 +1,28 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_INDICES_H_INCLUDED
+#define OBS_INDICES_H_INCLUDED
+#pragma once
+
+#include <cstddef>
+
+namespace obs {
+
+// Compile-time sequence of indices to expand tuples/arguments
+// (std::index_sequence is not available in C++11).
+template<std::size_t...I>
+struct indices { };
+
+template<std::size_t N, std::size_t...I>
+struct make_indices : make_indices<N-1, N-1, I...> { };
+
+template<std::size_t...I>
+struct make_indices<0, I...> { using type = indices<I...>; };
+
+} // namespace obs
+
+#endif
@@ -0,0 +1,452 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_JOURNAL_H_INCLUDED
+#define OBS_JOURNAL_H_INCLUDED
+#pragma once
+
+// Record signal emissions in a file and replay them later, e.g. to
+// profile slots with the real traffic of an application (this
+// header is POSIX-only and is not included in obs.h).
+
+#include "obs/connection.h"
+#include "obs/indices.h"
+#include "obs/payload_layout.h"
+#include "obs/signal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace obs {
+
+namespace journal_detail {
+
+const char magic[8] = { 'O', 'B', 'S', 'J', 'R', 'N', 'L', '\0' };
+const std::uint32_t version = 1;
+
+// Records are aligned to 8 bytes, so arguments can be read directly
+// from the mapped file.
+const std::size_t record_align = 8;
+
+// Header at the beginning of the file.
+struct file_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t reserved;
+};
+
+// Small index of the current thread (0 for the first thread that
+// records an emission, 1 for the next one, etc.).
+inline std::uint32_t thread_index() {
+  static std::atomic<std::uint32_t> next(0);
+  static thread_local std::uint32_t index = next++;
+  return index;
+}
+
+} // namespace journal_detail
+
+// One recorded emission in the file, followed by the payload (the
+// arguments of the emission).
+struct journal_record {
+  std::atomic<std::uint32_t> size; // Size of the record (0 if it was not completed)
+  std::uint32_t signal_id;         // ID given to journal_writer::record()
+  std::uint32_t thread;            // Index of the emitter thread
+  std::uint32_t payload_size;
+  std::uint64_t time;              // Nanoseconds since the journal was opened
+
+  const unsigned char* payload() const {
+    return reinterpret_cast<const unsigned char*>(this) + sizeof(journal_record);
+  }
+};
+
+// Appends emissions to a memory-mapped file. The file has a fixed
+// capacity (records that don't fit are counted in dropped()), and it
+// is truncated to the used size when it's closed. Emissions can be
+// recorded from several threads at the same time (each record is
+// reserved with an atomic increment and then copied to the mapped
+// file).
+//
+// Only signals with trivially copyable arguments can be recorded:
+//
+//   obs::journal_writer journal("session.obsj");
+//   obs::scoped_connection c = journal.record(sig, 1);
+//   ...
+//
+class journal_writer {
+public:
+  journal_writer() { }
+
+  explicit journal_writer(const std::string& path,
+                          std::size_t capacity = 64 << 20) {
+    open(path, capacity);
+  }
+
+  ~journal_writer() {
+    close();
+  }
+
+  journal_writer(const journal_writer&) = delete;
+  journal_writer& operator=(const journal_writer&) = delete;
+
+  // Creates (or truncates) the file with the given capacity in
+  // bytes. Returns false and sets errno if it cannot be created.
+  bool open(const std::string& path, std::size_t capacity = 64 << 20) {
+    close();
+
+    const std::size_t size =
+      payload_layout::align_up(std::max(capacity, sizeof(journal_detail::file_header)),
+                               journal_detail::record_align);
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+      return false;
+    if (::ftruncate(fd, off_t(size)) < 0) {
+      ::close(fd);
+      return false;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+
+    auto h = static_cast<journal_detail::file_header*>(addr);
+    std::memcpy(h->magic, journal_detail::magic, sizeof(h->magic));
+    h->version = journal_detail::version;
+    h->reserved = 0;
+
+    m_fd = fd;
+    m_addr = static_cast<unsigned char*>(addr);
+    m_capacity = size;
+    m_used.store(sizeof(journal_detail::file_header), std::memory_order_relaxed);
+    m_records.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_start = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  // Closes the file truncating it to the used size. Recorded signals
+  // must not be emitted while the journal is closed.
+  void close() {
+    if (!m_addr)
+      return;
+    const std::size_t used = size();
+    ::munmap(m_addr, m_capacity);
+    if (::ftruncate(m_fd, off_t(used)) < 0) {
+      // The file is still valid (the rest is filled with zeros)
+    }
+    ::close(m_fd);
+    m_addr = nullptr;
+    m_fd = -1;
+  }
+
+  bool is_open() const { return (m_addr != nullptr); }
+
+  // Records all emissions of the signal with the given ID, which
+  // identifies the signal in journal_replayer (it must be the same
+  // in the program that records and the one that replays). The
+  // emissions are recorded until the connection is disconnected.
+  template<typename...Args, template<typename> class List>
+  connection record(signal<void(Args...), List>& sig, std::uint32_t id) {
+    static_assert(payload_layout::all_trivially_copyable<
+                    typename std::decay<Args>::type...>::value,
+                  "recorded signals must have trivially copyable arguments");
+    return sig.connect(std::numeric_limits<int>::max(),
+                       [this, id](Args...args) {
+                         write(id, args...);
+                       });
+  }
+
+  // Appends one emission. Returns false if the file is full.
+  template<typename...Args>
+  bool write(std::uint32_t id, const Args&...args) {
+    static_assert(payload_layout::max_align<Args...>::value <= journal_detail::record_align,
+                  "journal arguments cannot be over-aligned");
+    const std::size_t payload = payload_layout::payload_offset<Args...>(0);
+    const std::size_t size =
+      payload_layout::align_up(sizeof(journal_record) + payload,
+                               journal_detail::record_align);
+    const std::uint64_t time = std::uint64_t(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+
+    const std::size_t offset = m_used.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > m_capacity) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    auto r = reinterpret_cast<journal_record*>(m_addr + offset);
+    r->signal_id = id;
+    r->thread = journal_detail::thread_index();
+    r->payload_size = std::uint32_t(payload);
+    r->time = time;
+    write_args<Args...>(const_cast<unsigned char*>(r->payload()),
+                        typename make_indices<sizeof...(Args)>::type(), args...);
+
+    // The record is completed when its size is set
+    r->size.store(std::uint32_t(size), std::memory_order_release);
+    m_records.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Used bytes of the file.
+  std::size_t size() const {
+    return std::min<std::size_t>(m_used.load(std::memory_order_relaxed), m_capacity);
+  }
+
+  std::size_t capacity() const { return m_capacity; }
+
+  // Number of recorded emissions, and emissions that didn't fit in
+  // the file.
+  std::uint64_t records() const { return m_records.load(std::memory_order_relaxed); }
+  std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+  template<typename...Args, std::size_t...I>
+  static void write_args(unsigned char* p, indices<I...>, const Args&...args) {
+    int dummy[] = { 0, (std::memcpy(p + payload_layout::arg_offset<I, Args...>(0),
+                                    &args, sizeof(Args)), 0)... };
+    (void)dummy;
+    (void)p;
+  }
+
+  int m_fd = -1;
+  unsigned char* m_addr = nullptr;
+  std::size_t m_capacity = 0;
+  std::atomic<std::size_t> m_used = { 0 };
+  std::atomic<std::uint64_t> m_records = { 0 };
+  std::atomic<std::uint64_t> m_dropped = { 0 };
+  std::chrono::steady_clock::time_point m_start;
+};
+
+// Reads the records of a journal file (mapped in memory).
+class journal_reader {
+public:
+  class iterator {
+  public:
+    iterator(const unsigned char* p, const unsigned char* end)
+      : m_p(p), m_end(end) {
+      validate();
+    }
+
+    const journal_record& operator*() const {
+      return *reinterpret_cast<const journal_record*>(m_p);
+    }
+    const journal_record* operator->() const { return &**this; }
+
+    iterator& operator++() {
+      m_p += (**this).size.load(std::memory_order_acquire);
+      validate();
+      return *this;
+    }
+
+    bool operator==(const iterator& other) const { return m_p == other.m_p; }
+    bool operator!=(const iterator& other) const { return m_p != other.m_p; }
+
+  private:
+    // Stops in the first incomplete or invalid record.
+    void validate() {
+      if (m_p == m_end)
+        return;
+      if (std::size_t(m_end - m_p) < sizeof(journal_record)) {
+        m_p = m_end;
+        return;
+      }
+      const journal_record& r = **this;
+      const std::size_t size = r.size.load(std::memory_order_acquire);
+      if (size < sizeof(journal_record) + r.payload_size ||
+          size % journal_detail::record_align != 0 ||
+          size > std::size_t(m_end - m_p))
+        m_p = m_end;
+    }
+
+    const unsigned char* m_p;
+    const unsigned char* m_end;
+  };
+
+  journal_reader() { }
+
+  explicit journal_reader(const std::string& path) {
+    open(path);
+  }
+
+  ~journal_reader() {
+    close();
+  }
+
+  journal_reader(const journal_reader&) = delete;
+  journal_reader& operator=(const journal_reader&) = delete;
+
+  // Returns false (and sets errno) if the file cannot be opened or
+  // it's not a journal.
+  bool open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+      ::close(fd);
+      return false;
+    }
+    const std::size_t size = std::size_t(st.st_size);
+    if (size < sizeof(journal_detail::file_header)) {
+      ::close(fd);
+      errno = EINVAL;
+      return false;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      return false;
+
+    auto h = static_cast<const journal_detail::file_header*>(addr);
+    if (std::memcmp(h->magic, journal_detail::magic, sizeof(h->magic)) != 0 ||
+        h->version != journal_detail::version) {
+      ::munmap(addr, size);
+      errno = EINVAL;
+      return false;
+    }
+
+    m_addr = static_cast<const unsigned char*>(addr);
+    m_size = size;
+    return true;
+  }
+
+  void close() {
+    if (m_addr) {
+      ::munmap(const_cast<unsigned char*>(m_addr), m_size);
+      m_addr = nullptr;
+      m_size = 0;
+    }
+  }
+
+  bool is_open() const { return (m_addr != nullptr); }
+
+  iterator begin() const {
+    if (!m_addr)
+      return iterator(nullptr, nullptr);
+    return iterator(m_addr + sizeof(journal_detail::file_header), m_addr + m_size);
+  }
+
+  iterator end() const {
+    return iterator(m_addr + m_size, m_addr + m_size);
+  }
+
+private:
+  const unsigned char* m_addr = nullptr;
+  std::size_t m_size = 0;
+};
+
+// Speed to replay a journal.
+enum class replay_speed {
+  recorded,                     // Same intervals between emissions
+  max,                          // Without waiting between emissions
+};
+
+// Emits the recorded emissions in the signals added with their IDs.
+// All emissions are replayed in the calling thread, in the same
+// order they were recorded.
+//
+//   obs::signal<void(int, double)> sig;
+//   sig.connect(slot_to_profile);
+//
+//   obs::journal_reader journal("session.obsj");
+//   obs::journal_replayer replayer;
+//   replayer.add(1, sig);
+//   replayer.replay(journal, obs::replay_speed::max);
+//
+class journal_replayer {
+public:
+  template<typename...Args, template<typename> class List>
+  void add(std::uint32_t id, signal<void(Args...), List>& sig) {
+    m_signals[id] = [&sig](const journal_record& r) -> bool {
+      return emit<Args...>(sig, r, typename make_indices<sizeof...(Args)>::type());
+    };
+  }
+
+  void remove(std::uint32_t id) {
+    m_signals.erase(id);
+  }
+
+  // Returns the number of replayed emissions. Records of unknown
+  // signals (or with a different payload) are skipped and counted
+  // in skipped().
+  std::size_t replay(const journal_reader& journal,
+                     replay_speed speed = replay_speed::max) {
+    std::size_t n = 0;
+    bool first = true;
+    std::uint64_t t0 = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const journal_record& r : journal) {
+      auto it = m_signals.find(r.signal_id);
+      if (it == m_signals.end()) {
+        ++m_skipped;
+        continue;
+      }
+
+      if (speed == replay_speed::recorded) {
+        if (first) {
+          t0 = r.time;
+          first = false;
+        }
+        if (r.time > t0)
+          std::this_thread::sleep_until(start + std::chrono::nanoseconds(r.time - t0));
+      }
+
+      if (it->second(r))
+        ++n;
+      else
+        ++m_skipped;
+    }
+    return n;
+  }
+
+  std::uint64_t skipped() const { return m_skipped; }
+
+private:
+  template<typename...Args, typename Signal, std::size_t...I>
+  static bool emit(Signal& sig, const journal_record& r, indices<I...>) {
+    static_assert(payload_layout::max_align<typename std::decay<Args>::type...>::value <=
+                  journal_detail::record_align,
+                  "journal arguments cannot be over-aligned");
+    if (r.payload_size != payload_layout::payload_offset<typename std::decay<Args>::type...>(0))
+      return false;
+    const unsigned char* p = r.payload();
+    sig(*reinterpret_cast<const typename std::decay<Args>::type*>(
+          p + payload_layout::arg_offset<I, typename std::decay<Args>::type...>(0))...);
+    (void)p;
+    return true;
+  }
+
+  std::map<std::uint32_t, std::function<bool(const journal_record&)>> m_signals;
+  std::uint64_t m_skipped = 0;
+};
+
+} // namespace obs
+
+#endif
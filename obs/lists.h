@@ -8,6 +8,7 @@
 #define OBS_LISTS_H_INCLUDED
 #pragma once
 
+#include "obs/cow_list.h"
 #include "obs/fast_list.h"
 #include "obs/safe_list.h"
 
@@ -25,9 +26,19 @@ template<typename T>
 safe_list<T>& iterate_list(safe_list<T>& list) { return list; }
 
 // To iterate a fast_list<> we need to copy it (so we can disconnect
-// from the same signal).
+// from the same signal). The copy reuses a buffer of the list, so
+// it doesn't allocate memory.
 template<typename T>
-fast_list<T> iterate_list(fast_list<T>& list) { return list; }
+typename fast_list<T>::snapshot iterate_list(fast_list<T>& list) {
+  return typename fast_list<T>::snapshot(list);
+}
+
+// A cow_list<> is iterated without copying it (modifications during
+// the iteration are done in a copy of its table).
+template<typename T>
+typename cow_list<T>::snapshot iterate_list(cow_list<T>& list) {
+  return typename cow_list<T>::snapshot(list);
+}
 
 } // namespace obs
 
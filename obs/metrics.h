@@ -0,0 +1,455 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_METRICS_H_INCLUDED
+#define OBS_METRICS_H_INCLUDED
+#pragma once
+
+// Metrics are available only when OBSERVABLE_METRICS is defined (see
+// the OBSERVABLE_METRICS option in CMakeLists.txt), in other case
+// signals/observers don't have any extra member or instruction to
+// keep track of them.
+#ifdef OBSERVABLE_METRICS
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace obs {
+
+// Histogram of durations (in nanoseconds) with logarithmic buckets:
+// each power of two is divided in 4 linear sub-buckets (similar to a
+// HDR histogram with 2 bits of precision).
+class histogram {
+public:
+  static constexpr int sub_bits = 2;
+  static constexpr int sub_buckets = (1 << sub_bits);
+  static constexpr int buckets = (64 - sub_bits + 1) * sub_buckets;
+
+  static int bucket_index(std::uint64_t v) {
+    if (v < sub_buckets)
+      return int(v);
+    const int msb = most_significant_bit(v);
+    const int sub = int((v >> (msb - sub_bits)) & (sub_buckets - 1));
+    return (msb - sub_bits + 1) * sub_buckets + sub;
+  }
+
+  // Lowest value that goes to the given bucket.
+  static std::uint64_t bucket_value(int i) {
+    if (i < sub_buckets)
+      return std::uint64_t(i);
+    const int msb = i / sub_buckets + sub_bits - 1;
+    const std::uint64_t sub = std::uint64_t(i % sub_buckets);
+    return (std::uint64_t(sub_buckets) + sub) << (msb - sub_bits);
+  }
+
+  histogram() {
+    std::fill(m_counts, m_counts+buckets, 0);
+  }
+
+  void add(int bucket, std::uint64_t count) { m_counts[bucket] += count; }
+  std::uint64_t count(int bucket) const { return m_counts[bucket]; }
+
+  std::uint64_t total() const {
+    std::uint64_t n = 0;
+    for (int i=0; i<buckets; ++i)
+      n += m_counts[i];
+    return n;
+  }
+
+  // Returns the lowest value of the bucket where the given
+  // percentile (0.0 to 100.0) is.
+  std::uint64_t percentile(double p) const {
+    const std::uint64_t n = total();
+    if (n == 0)
+      return 0;
+    std::uint64_t target = std::uint64_t(double(n) * p / 100.0);
+    if (target >= n)
+      target = n-1;
+    std::uint64_t acc = 0;
+    for (int i=0; i<buckets; ++i) {
+      acc += m_counts[i];
+      if (acc > target)
+        return bucket_value(i);
+    }
+    return bucket_value(buckets-1);
+  }
+
+private:
+  static int most_significant_bit(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int msb = 0;
+    while (v >>= 1)
+      ++msb;
+    return msb;
+#endif
+  }
+
+  std::uint64_t m_counts[buckets];
+};
+
+// A copy of the metrics in a specific moment.
+struct metrics_snapshot {
+  std::uint64_t emits = 0;          // Number of signal emissions/notifications
+  std::uint64_t slot_calls = 0;     // Number of called slots/observers
+  std::uint64_t emit_time = 0;      // Total time in emissions (nanoseconds)
+  std::uint64_t erase_waits = 0;    // Number of times erase() had to wait other threads
+  std::uint64_t erase_wait_time = 0; // Total time waiting in erase() (nanoseconds)
+  std::uint64_t erase_wait_max = 0; // Max time waiting in one erase() (nanoseconds)
+  int max_depth = 0;                // Max number of recursive emissions in the same thread
+  double elapsed = 0.0;             // Seconds since the metrics were created/reset
+  histogram emit_histogram;         // Distribution of emission times (nanoseconds)
+
+  double emit_rate() const {
+    return (elapsed > 0.0 ? double(emits) / elapsed: 0.0);
+  }
+};
+
+// Counters for emissions/erase waits. To avoid contention between
+// threads, each thread adds its values in a shard (allocated the
+// first time a thread uses it), and shards are summed in snapshot().
+//
+// There are at most 8 shards per metrics object (each one is ~2KB
+// because of the histogram), so threads share shards by index
+// (thread index modulo 8): with more than 8 emitting threads some
+// of them contend on the same cache lines again. Shards are
+// allocated lazily so signals that are emitted from just one thread
+// use one shard; the allocation happens in the first emission that
+// uses each shard (at most 8 times in the whole life of the signal).
+class metrics {
+public:
+  using clock = std::chrono::steady_clock;
+
+  metrics() : m_reset_time(clock::now().time_since_epoch().count()) {
+    for (auto& s : m_shards)
+      s = nullptr;
+  }
+
+  ~metrics() {
+    if (!m_name.empty())
+      set_name(std::string());
+    for (auto& s : m_shards)
+      delete s.load();
+  }
+
+  metrics(const metrics&) = delete;
+  metrics& operator=(const metrics&) = delete;
+
+  static std::uint64_t elapsed(clock::time_point start) {
+    return std::uint64_t(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now() - start).count());
+  }
+
+  // Named metrics are added to the registry to be included in
+  // report_metrics(). An empty name removes them from the registry.
+  void set_name(const std::string& name);
+  std::string name() const;
+
+  // Called at the beginning/end of each emission. It keeps track of
+  // the recursion depth (how many times the same signal is being
+  // emitted from its own slots in the same thread).
+  clock::time_point begin_emit() {
+    emit_stack& st = thread_emit_stack();
+    int depth = 1;
+    const int n = (st.size < emit_stack::max_size ? st.size: emit_stack::max_size);
+    for (int i=0; i<n; ++i)
+      if (st.items[i] == this)
+        ++depth;
+    if (st.size < emit_stack::max_size)
+      st.items[st.size] = this;
+    ++st.size;
+
+    shard& s = get_shard();
+    if (depth > s.max_depth.load(std::memory_order_relaxed))
+      s.max_depth.store(depth, std::memory_order_relaxed);
+    return clock::now();
+  }
+
+  void end_emit(clock::time_point start, std::uint64_t slot_calls) {
+    --thread_emit_stack().size;
+    add_emit(elapsed(start), slot_calls);
+  }
+
+  void add_emit(std::uint64_t ns, std::uint64_t slot_calls) {
+    shard& s = get_shard();
+    s.emits.fetch_add(1, std::memory_order_relaxed);
+    s.slot_calls.fetch_add(slot_calls, std::memory_order_relaxed);
+    s.emit_time.fetch_add(ns, std::memory_order_relaxed);
+    s.emit_histogram[histogram::bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void add_erase_wait(std::uint64_t ns) {
+    shard& s = get_shard();
+    s.erase_waits.fetch_add(1, std::memory_order_relaxed);
+    s.erase_wait_time.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > s.erase_wait_max.load(std::memory_order_relaxed))
+      s.erase_wait_max.store(ns, std::memory_order_relaxed);
+  }
+
+  metrics_snapshot snapshot() const {
+    metrics_snapshot r;
+    r.elapsed = std::chrono::duration<double>(
+      clock::now().time_since_epoch() -
+      clock::duration(m_reset_time.load(std::memory_order_relaxed))).count();
+    for (auto& p : m_shards) {
+      const shard* s = p.load(std::memory_order_acquire);
+      if (!s)
+        continue;
+      r.emits += s->emits.load(std::memory_order_relaxed);
+      r.slot_calls += s->slot_calls.load(std::memory_order_relaxed);
+      r.emit_time += s->emit_time.load(std::memory_order_relaxed);
+      r.erase_waits += s->erase_waits.load(std::memory_order_relaxed);
+      r.erase_wait_time += s->erase_wait_time.load(std::memory_order_relaxed);
+      r.erase_wait_max = std::max<std::uint64_t>(
+        r.erase_wait_max, s->erase_wait_max.load(std::memory_order_relaxed));
+      r.max_depth = std::max<int>(
+        r.max_depth, s->max_depth.load(std::memory_order_relaxed));
+      for (int i=0; i<histogram::buckets; ++i)
+        r.emit_histogram.add(i, s->emit_histogram[i].load(std::memory_order_relaxed));
+    }
+    return r;
+  }
+
+  void reset() {
+    m_reset_time = clock::now().time_since_epoch().count();
+    for (auto& p : m_shards) {
+      shard* s = p.load(std::memory_order_acquire);
+      if (s)
+        s->reset();
+    }
+  }
+
+private:
+  // Max number of shards (a trade-off between the contention with
+  // several threads and the memory used by each signal).
+  static constexpr int max_shards = 8;
+
+  // Each shard is allocated in its own heap block, so threads don't
+  // share cache lines in the common case.
+  struct shard {
+    std::atomic<std::uint64_t> emits;
+    std::atomic<std::uint64_t> slot_calls;
+    std::atomic<std::uint64_t> emit_time;
+    std::atomic<std::uint64_t> erase_waits;
+    std::atomic<std::uint64_t> erase_wait_time;
+    std::atomic<std::uint64_t> erase_wait_max;
+    std::atomic<int> max_depth;
+    std::atomic<std::uint64_t> emit_histogram[histogram::buckets];
+
+    shard() { reset(); }
+
+    void reset() {
+      emits = 0;
+      slot_calls = 0;
+      emit_time = 0;
+      erase_waits = 0;
+      erase_wait_time = 0;
+      erase_wait_max = 0;
+      max_depth = 0;
+      for (auto& c : emit_histogram)
+        c = 0;
+    }
+  };
+
+  // Metrics being emitted in the current thread (to calculate the
+  // recursion depth).
+  struct emit_stack {
+    static constexpr int max_size = 64;
+    const metrics* items[max_size];
+    int size = 0;
+  };
+
+  static emit_stack& thread_emit_stack() {
+    static thread_local emit_stack st;
+    return st;
+  }
+
+  // Each thread uses always the same shard index in all metrics (the
+  // 9th thread uses the same shard as the 1st one, etc.).
+  static int thread_shard_index() {
+    static std::atomic<int> next_index(0);
+    static thread_local int index = (next_index++ % max_shards);
+    return index;
+  }
+
+  shard& get_shard() {
+    std::atomic<shard*>& p = m_shards[thread_shard_index()];
+    shard* s = p.load(std::memory_order_acquire);
+    if (!s) {
+      shard* n = new shard;
+      if (p.compare_exchange_strong(s, n, std::memory_order_acq_rel))
+        s = n;
+      else
+        delete n;
+    }
+    return *s;
+  }
+
+  std::atomic<shard*> m_shards[max_shards];
+  std::atomic<clock::rep> m_reset_time;
+
+  // Name of the metrics in the registry (protected by the registry
+  // mutex).
+  friend class metrics_registry;
+  std::string m_name;
+};
+
+// Metrics that are not associated to a specific signal (e.g. time
+// waiting in safe_list::erase()).
+inline metrics& global_metrics() {
+  static metrics m;
+  return m;
+}
+
+// Global list of named metrics.
+class metrics_registry {
+public:
+  static metrics_registry& instance() {
+    // Never deleted, so signals with static storage can be
+    // unregistered at exit.
+    static metrics_registry* r = new metrics_registry;
+    return *r;
+  }
+
+  void add(metrics* m) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_metrics.push_back(m);
+  }
+
+  void remove(metrics* m) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find(m_metrics.begin(), m_metrics.end(), m);
+    if (it != m_metrics.end())
+      m_metrics.erase(it);
+  }
+
+  struct entry {
+    std::string name;
+    metrics_snapshot snapshot;
+  };
+
+  // Returns the snapshots of all named metrics sorted by the total
+  // time spent in emissions.
+  std::vector<entry> top(std::size_t max_entries) {
+    std::vector<entry> entries;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      entries.reserve(m_metrics.size());
+      for (const metrics* m : m_metrics)
+        entries.push_back({ m->m_name, m->snapshot() });
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const entry& a, const entry& b) {
+                return a.snapshot.emit_time > b.snapshot.emit_time;
+              });
+    if (entries.size() > max_entries)
+      entries.resize(max_entries);
+    return entries;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (metrics* m : m_metrics)
+      m->reset();
+  }
+
+private:
+  friend class metrics;
+
+  // Used to lock m_metrics and the names of all metrics.
+  std::mutex m_mutex;
+  std::vector<metrics*> m_metrics;
+};
+
+inline void metrics::set_name(const std::string& name) {
+  metrics_registry& r = metrics_registry::instance();
+  if (!m_name.empty())
+    r.remove(this);
+  {
+    std::lock_guard<std::mutex> lock(r.m_mutex);
+    m_name = name;
+  }
+  if (!m_name.empty())
+    r.add(this);
+}
+
+inline std::string metrics::name() const {
+  std::lock_guard<std::mutex> lock(metrics_registry::instance().m_mutex);
+  return m_name;
+}
+
+enum class report_format { text, json };
+
+// Writes a report of the most expensive named signals/observers
+// (sorted by the total time spent in their emissions).
+inline void report_metrics(std::ostream& os,
+                           report_format format = report_format::text,
+                           std::size_t max_entries = 20) {
+  auto entries = metrics_registry::instance().top(max_entries);
+
+  if (format == report_format::json) {
+    os << "[";
+    for (std::size_t i=0; i<entries.size(); ++i) {
+      const auto& e = entries[i];
+      const auto& s = e.snapshot;
+      os << (i ? ",\n " : "\n ") << "{\"name\":\"";
+      for (char c : e.name) {
+        if (c == '"' || c == '\\')
+          os << '\\' << c;
+        else if (c >= 0 && c < 0x20)
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << int(c) << std::dec << std::setfill(' ');
+        else
+          os << c;
+      }
+      os << "\",\"emits\":" << s.emits
+         << ",\"emit_rate\":" << s.emit_rate()
+         << ",\"slot_calls\":" << s.slot_calls
+         << ",\"emit_time_ns\":" << s.emit_time
+         << ",\"p50_ns\":" << s.emit_histogram.percentile(50)
+         << ",\"p99_ns\":" << s.emit_histogram.percentile(99)
+         << ",\"max_depth\":" << s.max_depth << "}";
+    }
+    os << "\n]\n";
+    return;
+  }
+
+  os << std::left << std::setw(32) << "signal" << std::right
+     << std::setw(12) << "emits"
+     << std::setw(12) << "emits/s"
+     << std::setw(12) << "slots"
+     << std::setw(14) << "time (ms)"
+     << std::setw(12) << "p50 (ns)"
+     << std::setw(12) << "p99 (ns)"
+     << std::setw(8) << "depth" << "\n";
+  for (const auto& e : entries) {
+    const auto& s = e.snapshot;
+    os << std::left << std::setw(32) << e.name << std::right
+       << std::setw(12) << s.emits
+       << std::setw(12) << std::fixed << std::setprecision(1) << s.emit_rate()
+       << std::setw(12) << s.slot_calls
+       << std::setw(14) << std::setprecision(3) << (double(s.emit_time) / 1e6)
+       << std::setw(12) << s.emit_histogram.percentile(50)
+       << std::setw(12) << s.emit_histogram.percentile(99)
+       << std::setw(8) << s.max_depth << "\n";
+  }
+}
+
+} // namespace obs
+
+#endif // OBSERVABLE_METRICS
+
+#endif
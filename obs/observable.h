@@ -33,6 +33,10 @@ public:
     m_observers.template notify_observers<Args...>(method, std::forward<Args>(args)...);
   }
 
+  void set_name(const char* name) {
+    m_observers.set_name(name);
+  }
+
 private:
   List m_observers;
 };
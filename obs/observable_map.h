@@ -0,0 +1,241 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_OBSERVABLE_MAP_H_INCLUDED
+#define OBS_OBSERVABLE_MAP_H_INCLUDED
+#pragma once
+
+#include "obs/signal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace obs {
+
+// Keys of an observable_map<> that were inserted, erased, or updated
+// in one notification (each key appears in one list only, and the
+// lists are sorted).
+template<typename Key>
+struct map_diff {
+  std::vector<Key> inserted;
+  std::vector<Key> erased;
+  std::vector<Key> updated;
+
+  bool empty() const {
+    return (inserted.empty() && erased.empty() && updated.empty());
+  }
+
+  void clear() {
+    inserted.clear();
+    erased.clear();
+    updated.clear();
+  }
+};
+
+// A std::map<> wrapper which notifies its modifications with the
+// "changed" signal as sets of inserted/erased/updated keys. Values
+// can be read directly, but they must be modified with the member
+// functions of the map (e.g. insert_or_assign() or update()).
+//
+// Modifications inside a transaction are accumulated and notified
+// once when the outermost transaction ends. The changes of the same
+// key are merged (e.g. a key that was inserted and erased in the same
+// transaction is not notified, and a key that was erased and inserted
+// again is notified as updated).
+template<typename Key, typename Value,
+         typename Compare = std::less<Key>,
+         template<typename> class List = default_list>
+class observable_map {
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using map_type = std::map<Key, Value, Compare>;
+  using value_type = typename map_type::value_type;
+  using size_type = std::size_t;
+  using const_iterator = typename map_type::const_iterator;
+  using diff_type = map_diff<Key>;
+  using signal_type = signal<void(const diff_type&), List>;
+
+  class transaction {
+  public:
+    explicit transaction(observable_map& m) : m_map(m) {
+      ++m_map.m_transactions;
+    }
+
+    ~transaction() {
+      if (--m_map.m_transactions == 0)
+        m_map.notify();
+    }
+
+    transaction(const transaction&) = delete;
+    transaction& operator=(const transaction&) = delete;
+
+  private:
+    observable_map& m_map;
+  };
+
+  observable_map() { }
+
+  // The copy has the same elements, but the slots of the "changed"
+  // signal are copied only with cow_list<> (see obs::signal).
+  observable_map(const observable_map& other)
+    : changed(other.changed),
+      m_items(other.m_items) {
+  }
+
+  observable_map& operator=(const observable_map& other) {
+    transaction t(*this);
+    clear();
+    insert(other.m_items.begin(), other.m_items.end());
+    return *this;
+  }
+
+  // Signal emitted with the changes of each modification (or
+  // transaction).
+  signal_type changed;
+
+  bool empty() const { return m_items.empty(); }
+  size_type size() const { return m_items.size(); }
+  size_type count(const Key& key) const { return m_items.count(key); }
+  const_iterator find(const Key& key) const { return m_items.find(key); }
+  const Value& at(const Key& key) const { return m_items.at(key); }
+  const_iterator begin() const { return m_items.begin(); }
+  const_iterator end() const { return m_items.end(); }
+
+  // Read-only access to the wrapped map.
+  const map_type& items() const { return m_items; }
+
+  bool in_transaction() const { return m_transactions > 0; }
+
+  // Inserts the value if the key is not in the map yet, returns true
+  // if it was inserted.
+  bool insert(const Key& key, const Value& value) {
+    if (!m_items.insert(value_type(key, value)).second)
+      return false;
+    add_change(key, change::insert);
+    return true;
+  }
+
+  // Inserts a range of key/value pairs (one notification).
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    transaction t(*this);
+    for (; first != last; ++first)
+      insert(first->first, first->second);
+  }
+
+  // Inserts the value or replaces the existent one.
+  void insert_or_assign(const Key& key, const Value& value) {
+    auto it = m_items.lower_bound(key);
+    if (it != m_items.end() && !m_items.key_comp()(key, it->first)) {
+      it->second = value;
+      add_change(key, change::update);
+    }
+    else {
+      m_items.insert(it, value_type(key, value));
+      add_change(key, change::insert);
+    }
+  }
+
+  // Modifies the value of the given key with f(Value&), returns false
+  // if the key is not in the map.
+  template<typename Function>
+  bool update(const Key& key, Function&& f) {
+    auto it = m_items.find(key);
+    if (it == m_items.end())
+      return false;
+    f(it->second);
+    add_change(key, change::update);
+    return true;
+  }
+
+  size_type erase(const Key& key) {
+    if (m_items.erase(key) == 0)
+      return 0;
+    add_change(key, change::erase);
+    return 1;
+  }
+
+  void clear() {
+    if (m_items.empty())
+      return;
+    transaction t(*this);
+    for (const auto& kv : m_items)
+      m_log.push_back(std::make_pair(kv.first, change::erase));
+    m_items.clear();
+  }
+
+private:
+  enum class change { none, insert, erase, update };
+
+  // Result of applying the change "b" after "a" to the same key.
+  static change merge(change a, change b) {
+    switch (a) {
+      case change::none: return b;
+      case change::insert: return (b == change::erase ? change::none: change::insert);
+      case change::erase: return (b == change::insert ? change::update: change::erase);
+      case change::update: return (b == change::erase ? change::erase: change::update);
+    }
+    return b;
+  }
+
+  void add_change(const Key& key, change c) {
+    m_log.push_back(std::make_pair(key, c));
+    if (m_transactions == 0)
+      notify();
+  }
+
+  // Converts the log of changes in a diff, merging the changes of
+  // each key (in the same order that they were made).
+  void make_diff(diff_type& diff) {
+    const Compare& less = m_items.key_comp();
+    std::stable_sort(m_log.begin(), m_log.end(),
+                     [&less](const std::pair<Key, change>& a,
+                             const std::pair<Key, change>& b) {
+                       return less(a.first, b.first);
+                     });
+
+    for (auto it=m_log.begin(); it!=m_log.end(); ) {
+      change c = change::none;
+      auto next = it;
+      for (; next!=m_log.end() && !less(it->first, next->first); ++next)
+        c = merge(c, next->second);
+
+      switch (c) {
+        case change::none: break;
+        case change::insert: diff.inserted.push_back(it->first); break;
+        case change::erase: diff.erased.push_back(it->first); break;
+        case change::update: diff.updated.push_back(it->first); break;
+      }
+      it = next;
+    }
+    m_log.clear();
+  }
+
+  void notify() {
+    if (m_log.empty())
+      return;
+
+    // Slots can modify the map (their changes are notified in a
+    // nested emission), so the diff is built in the stack.
+    diff_type diff;
+    make_diff(diff);
+    if (!diff.empty())
+      changed(diff);
+  }
+
+  map_type m_items;
+  std::vector<std::pair<Key, change>> m_log;
+  int m_transactions = 0;
+};
+
+} // namespace obs
+
+#endif
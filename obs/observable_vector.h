@@ -0,0 +1,317 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_OBSERVABLE_VECTOR_H_INCLUDED
+#define OBS_OBSERVABLE_VECTOR_H_INCLUDED
+#pragma once
+
+#include "obs/signal.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace obs {
+
+// A range of elements of an observable_vector<> that was inserted,
+// erased, or updated (assigned).
+struct vector_change {
+  enum kind { insert, erase, update };
+
+  kind type;
+  std::size_t first;   // Index of the first element
+  std::size_t count;   // Number of elements
+
+  std::size_t last() const { return first + count; }
+};
+
+// Changes of an observable_vector<> in one notification. They must be
+// applied in order (the indexes of each change refer to the vector
+// after the previous changes). Consecutive changes of the same kind
+// on adjacent ranges are merged, so inserting/erasing/updating N
+// contiguous elements is just one change.
+class vector_diff {
+public:
+  using const_iterator = std::vector<vector_change>::const_iterator;
+
+  bool empty() const { return m_changes.empty(); }
+  std::size_t size() const { return m_changes.size(); }
+  const vector_change& operator[](std::size_t i) const { return m_changes[i]; }
+  const_iterator begin() const { return m_changes.begin(); }
+  const_iterator end() const { return m_changes.end(); }
+
+  void clear() { m_changes.clear(); }
+  void swap(vector_diff& other) { m_changes.swap(other.m_changes); }
+
+  void add(vector_change::kind type, std::size_t first, std::size_t count) {
+    if (count == 0)
+      return;
+
+    if (!m_changes.empty()) {
+      vector_change& prev = m_changes.back();
+      switch (type) {
+
+        case vector_change::insert:
+          // Inserted inside or at the end of the previous insertion
+          if (prev.type == vector_change::insert &&
+              first >= prev.first && first <= prev.last()) {
+            prev.count += count;
+            return;
+          }
+          break;
+
+        case vector_change::erase:
+          if (prev.type == vector_change::erase) {
+            // Erased at the same index (forward) or just before it
+            // (backward)
+            if (first == prev.first) {
+              prev.count += count;
+              return;
+            }
+            if (first + count == prev.first) {
+              prev.first = first;
+              prev.count += count;
+              return;
+            }
+          }
+          break;
+
+        case vector_change::update:
+          // Updated elements that were just inserted
+          if (prev.type == vector_change::insert &&
+              first >= prev.first && first + count <= prev.last())
+            return;
+
+          // Overlapped or adjacent updates
+          if (prev.type == vector_change::update &&
+              first <= prev.last() && first + count >= prev.first) {
+            const std::size_t last = std::max(prev.last(), first + count);
+            prev.first = std::min(prev.first, first);
+            prev.count = last - prev.first;
+            return;
+          }
+          break;
+      }
+    }
+    m_changes.push_back(vector_change{ type, first, count });
+  }
+
+private:
+  std::vector<vector_change> m_changes;
+};
+
+// A std::vector<> wrapper which notifies its modifications with the
+// "changed" signal as ranges of inserted/erased/updated elements.
+// Elements can be read directly, but they must be modified with the
+// member functions of the vector (e.g. set() or update()).
+//
+// Each modification emits one notification (a bulk insert/erase is
+// just one range), and modifications inside a transaction are
+// accumulated and emitted once when the outermost transaction ends:
+//
+//   obs::observable_vector<int> v;
+//   v.changed.connect([](const obs::vector_diff& diff){ ... });
+//   {
+//     obs::observable_vector<int>::transaction t(v);
+//     for (int i=0; i<100000; ++i)
+//       v.push_back(i);
+//   } // One notification with one inserted range [0, 100000)
+//
+template<typename T, template<typename> class List = default_list>
+class observable_vector {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_reference = const T&;
+  using const_iterator = typename std::vector<T>::const_iterator;
+  using signal_type = signal<void(const vector_diff&), List>;
+
+  // Accumulates all the changes in the vector in its scope, and
+  // notifies them when the outermost transaction is destroyed.
+  class transaction {
+  public:
+    explicit transaction(observable_vector& v) : m_vector(v) {
+      ++m_vector.m_transactions;
+    }
+
+    ~transaction() {
+      if (--m_vector.m_transactions == 0)
+        m_vector.notify();
+    }
+
+    transaction(const transaction&) = delete;
+    transaction& operator=(const transaction&) = delete;
+
+  private:
+    observable_vector& m_vector;
+  };
+
+  observable_vector() { }
+  observable_vector(std::initializer_list<T> values) : m_items(values) { }
+
+  // The copy has the same elements, but the slots of the "changed"
+  // signal are copied only with cow_list<> (see obs::signal).
+  observable_vector(const observable_vector& other)
+    : changed(other.changed),
+      m_items(other.m_items) {
+  }
+
+  observable_vector& operator=(const observable_vector& other) {
+    assign(other.m_items.begin(), other.m_items.end());
+    return *this;
+  }
+
+  // Signal emitted with the changes of each modification (or
+  // transaction).
+  signal_type changed;
+
+  bool empty() const { return m_items.empty(); }
+  size_type size() const { return m_items.size(); }
+  size_type capacity() const { return m_items.capacity(); }
+  void reserve(size_type n) { m_items.reserve(n); }
+
+  const_reference operator[](size_type i) const { return m_items[i]; }
+  const_reference at(size_type i) const { return m_items.at(i); }
+  const_reference front() const { return m_items.front(); }
+  const_reference back() const { return m_items.back(); }
+  const T* data() const { return m_items.data(); }
+  const_iterator begin() const { return m_items.begin(); }
+  const_iterator end() const { return m_items.end(); }
+
+  // Read-only access to the wrapped vector.
+  const std::vector<T>& items() const { return m_items; }
+
+  // True if a transaction is in progress.
+  bool in_transaction() const { return m_transactions > 0; }
+
+  template<typename...Args>
+  void emplace_back(Args&&...args) {
+    m_items.emplace_back(std::forward<Args>(args)...);
+    add_change(vector_change::insert, m_items.size()-1, 1);
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    assert(!m_items.empty());
+    m_items.pop_back();
+    add_change(vector_change::erase, m_items.size(), 1);
+  }
+
+  template<typename...Args>
+  void emplace(size_type pos, Args&&...args) {
+    assert(pos <= m_items.size());
+    m_items.emplace(m_items.begin()+pos, std::forward<Args>(args)...);
+    add_change(vector_change::insert, pos, 1);
+  }
+
+  void insert(size_type pos, const T& value) { emplace(pos, value); }
+  void insert(size_type pos, T&& value) { emplace(pos, std::move(value)); }
+
+  // Inserts the range [first, last) in "pos" (one change).
+  template<typename InputIterator>
+  void insert(size_type pos, InputIterator first, InputIterator last) {
+    assert(pos <= m_items.size());
+    const size_type n = m_items.size();
+    m_items.insert(m_items.begin()+pos, first, last);
+    add_change(vector_change::insert, pos, m_items.size() - n);
+  }
+
+  void insert(size_type pos, std::initializer_list<T> values) {
+    insert(pos, values.begin(), values.end());
+  }
+
+  void erase(size_type pos) {
+    erase(pos, pos+1);
+  }
+
+  // Erases the elements in [first, last) (one change).
+  void erase(size_type first, size_type last) {
+    assert(first <= last && last <= m_items.size());
+    m_items.erase(m_items.begin()+first, m_items.begin()+last);
+    add_change(vector_change::erase, first, last - first);
+  }
+
+  void clear() {
+    erase(0, m_items.size());
+  }
+
+  // Replaces all elements (one erase + one insert).
+  template<typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    transaction t(*this);
+    clear();
+    insert(0, first, last);
+  }
+
+  void resize(size_type n, const T& value = T()) {
+    const size_type old = m_items.size();
+    m_items.resize(n, value);
+    if (n > old)
+      add_change(vector_change::insert, old, n - old);
+    else if (n < old)
+      add_change(vector_change::erase, n, old - n);
+  }
+
+  void set(size_type i, const T& value) {
+    m_items[i] = value;
+    add_change(vector_change::update, i, 1);
+  }
+
+  void set(size_type i, T&& value) {
+    m_items[i] = std::move(value);
+    add_change(vector_change::update, i, 1);
+  }
+
+  // Modifies the elements in [first, last) with f(T&) (one change).
+  template<typename Function>
+  void update(size_type first, size_type last, Function&& f) {
+    assert(first <= last && last <= m_items.size());
+    for (size_type i=first; i<last; ++i)
+      f(m_items[i]);
+    add_change(vector_change::update, first, last - first);
+  }
+
+  template<typename Function>
+  void update(size_type i, Function&& f) {
+    update(i, i+1, std::forward<Function>(f));
+  }
+
+private:
+  void add_change(vector_change::kind type, size_type first, size_type count) {
+    m_diff.add(type, first, count);
+    if (m_transactions == 0)
+      notify();
+  }
+
+  void notify() {
+    if (m_diff.empty())
+      return;
+
+    // Slots can modify the vector (their changes are notified in a
+    // nested emission), so the diff is moved to the stack. The buffer
+    // of the diff is reused between notifications.
+    vector_diff diff;
+    diff.swap(m_diff);
+    changed(diff);
+    diff.clear();
+    if (m_diff.empty())
+      m_diff.swap(diff);
+  }
+
+  std::vector<T> m_items;
+  vector_diff m_diff;
+  int m_transactions = 0;
+};
+
+} // namespace obs
+
+#endif
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "obs/lists.h"
+#include "obs/metrics.h"
 
 namespace obs {
 
@@ -32,14 +33,44 @@ public:
 
   template<typename ...Args>
   void notify_observers(void (observer_type::*method)(Args...), Args ...args) {
+#ifdef OBSERVABLE_METRICS
+    auto t0 = m_metrics.begin_emit();
+    std::uint64_t calls = 0;
+#endif
     for (auto observer : iterate_list(m_observers)) {
-      if (observer)
+      if (observer) {
         (observer->*method)(std::forward<Args>(args)...);
+#ifdef OBSERVABLE_METRICS
+        ++calls;
+#endif
+      }
     }
+#ifdef OBSERVABLE_METRICS
+    m_metrics.end_emit(t0, calls);
+#endif
   }
 
+  // Names this instance to be identified in obs::report_metrics().
+  // It does nothing if OBSERVABLE_METRICS is not defined.
+  void set_name(const char* name) {
+#ifdef OBSERVABLE_METRICS
+    m_metrics.set_name(name);
+#else
+    (void)name;
+#endif
+  }
+
+#ifdef OBSERVABLE_METRICS
+  // Notification counters and times.
+  obs::metrics& metrics() { return m_metrics; }
+  const obs::metrics& metrics() const { return m_metrics; }
+#endif
+
 private:
   list_type m_observers;
+#ifdef OBSERVABLE_METRICS
+  obs::metrics m_metrics;
+#endif
 };
 
 template<typename T>
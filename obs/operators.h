@@ -0,0 +1,332 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_OPERATORS_H_INCLUDED
+#define OBS_OPERATORS_H_INCLUDED
+#pragma once
+
+#include "obs/connection.h"
+#include "obs/signal.h"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Operators to build a transformed/filtered stream from signals
+// without intermediate signals. E.g.
+//
+//   obs::signal<void(int)> sig;
+//   obs::scoped_connection c =
+//     (obs::from(sig)
+//      | obs::filter([](int x){ return x > 0; })
+//      | obs::map([](int x){ return x*2; }))
+//     .connect([](int y){ ... });
+//
+// All stages are fused at compile time in just one slot, so each
+// event costs one std::function call (the slot itself) and the rest
+// of the pipeline can be inlined by the compiler.
+
+namespace obs {
+
+namespace operators_detail {
+
+// Last stage of a pipeline, calls the user function.
+template<typename F>
+struct sink_stage {
+  F f;
+
+  template<typename...A>
+  void operator()(A&&...a) {
+    f(std::forward<A>(a)...);
+  }
+};
+
+template<typename F, typename Next>
+struct map_stage {
+  F f;
+  Next next;
+
+  template<typename...A>
+  void operator()(A&&...a) {
+    next(f(std::forward<A>(a)...));
+  }
+};
+
+template<typename P, typename Next>
+struct filter_stage {
+  P p;
+  Next next;
+
+  template<typename...A>
+  void operator()(A&&...a) {
+    if (p(a...))
+      next(std::forward<A>(a)...);
+  }
+};
+
+// Stops passing events forever after the first time the predicate
+// returns false. As the slot can be called from several threads
+// (safe_list), the state is atomic.
+template<typename P, typename Next>
+struct take_while_stage {
+  P p;
+  Next next;
+  std::atomic<bool> done;
+
+  take_while_stage(P p, Next next)
+    : p(std::move(p)), next(std::move(next)), done(false) { }
+
+  take_while_stage(const take_while_stage& other)
+    : p(other.p), next(other.next), done(other.done.load()) { }
+
+  take_while_stage(take_while_stage&& other)
+    : p(std::move(other.p)), next(std::move(other.next)), done(other.done.load()) { }
+
+  template<typename...A>
+  void operator()(A&&...a) {
+    if (done.load(std::memory_order_relaxed))
+      return;
+    if (!p(a...)) {
+      done.store(true, std::memory_order_relaxed);
+      return;
+    }
+    next(std::forward<A>(a)...);
+  }
+};
+
+// Passes at most one event per "interval", other events are dropped.
+template<typename Next>
+struct throttle_stage {
+  using clock = std::chrono::steady_clock;
+  using rep = clock::duration::rep;
+
+  clock::duration interval;
+  Next next;
+  std::atomic<rep> last;
+
+  throttle_stage(clock::duration interval, Next next)
+    : interval(interval), next(std::move(next)),
+      last(std::numeric_limits<rep>::min()) { }
+
+  throttle_stage(const throttle_stage& other)
+    : interval(other.interval), next(other.next), last(other.last.load()) { }
+
+  throttle_stage(throttle_stage&& other)
+    : interval(other.interval), next(std::move(other.next)), last(other.last.load()) { }
+
+  template<typename...A>
+  void operator()(A&&...a) {
+    const rep now = clock::now().time_since_epoch().count();
+    rep prev = last.load(std::memory_order_relaxed);
+    if (prev != std::numeric_limits<rep>::min() &&
+        now - prev < interval.count())
+      return;
+    // Only one thread can pass the event for this interval.
+    if (!last.compare_exchange_strong(prev, now, std::memory_order_relaxed))
+      return;
+    next(std::forward<A>(a)...);
+  }
+};
+
+// Operators (the values returned by obs::map(), obs::filter(),
+// etc.), they know how to wrap the next stage of the pipeline.
+
+template<typename F>
+struct map_op {
+  F f;
+  template<typename Next>
+  map_stage<F, typename std::decay<Next>::type> bind(Next&& next) const {
+    return { f, std::forward<Next>(next) };
+  }
+};
+
+template<typename P>
+struct filter_op {
+  P p;
+  template<typename Next>
+  filter_stage<P, typename std::decay<Next>::type> bind(Next&& next) const {
+    return { p, std::forward<Next>(next) };
+  }
+};
+
+template<typename P>
+struct take_while_op {
+  P p;
+  template<typename Next>
+  take_while_stage<P, typename std::decay<Next>::type> bind(Next&& next) const {
+    return take_while_stage<P, typename std::decay<Next>::type>(p, std::forward<Next>(next));
+  }
+};
+
+struct throttle_op {
+  std::chrono::steady_clock::duration interval;
+  template<typename Next>
+  throttle_stage<typename std::decay<Next>::type> bind(Next&& next) const {
+    return throttle_stage<typename std::decay<Next>::type>(interval, std::forward<Next>(next));
+  }
+};
+
+// Builders compose operators from left to right, so the first
+// operator in the pipeline wraps all the following ones.
+struct identity_builder {
+  template<typename Next>
+  typename std::decay<Next>::type operator()(Next&& next) const {
+    return std::forward<Next>(next);
+  }
+};
+
+template<typename Outer, typename Op>
+struct compose_builder {
+  Outer outer;
+  Op op;
+
+  template<typename Next>
+  auto operator()(Next&& next) const
+    -> decltype(std::declval<const Outer&>()(std::declval<const Op&>().bind(std::forward<Next>(next)))) {
+    return outer(op.bind(std::forward<Next>(next)));
+  }
+};
+
+template<typename Signal>
+class signal_source { };
+
+template<typename...Args, template<typename> class List>
+class signal_source<signal<void(Args...), List>> {
+public:
+  using signal_type = signal<void(Args...), List>;
+
+  explicit signal_source(signal_type& sig) : m_sig(sig) { }
+
+  template<typename Stage>
+  connection connect(Stage stage) {
+    return m_sig.connect(
+      [stage](Args...args) mutable {
+        stage(std::forward<Args>(args)...);
+      });
+  }
+
+private:
+  signal_type& m_sig;
+};
+
+template<typename...Signals>
+class merge_source { };
+
+template<>
+class merge_source<> {
+public:
+  template<typename Stage>
+  void connect_shared(const std::shared_ptr<Stage>&,
+                      std::vector<connection>&) { }
+};
+
+template<typename...Args, template<typename> class List, typename...Rest>
+class merge_source<signal<void(Args...), List>, Rest...> {
+public:
+  using signal_type = signal<void(Args...), List>;
+
+  explicit merge_source(signal_type& sig, Rest&...rest)
+    : m_sig(sig), m_rest(rest...) { }
+
+  template<typename Stage>
+  std::vector<connection> connect(Stage stage) {
+    std::vector<connection> conns;
+    conns.reserve(1+sizeof...(Rest));
+    connect_shared(std::make_shared<Stage>(std::move(stage)), conns);
+    return conns;
+  }
+
+  // The same fused pipeline is shared by all signals.
+  template<typename Stage>
+  void connect_shared(const std::shared_ptr<Stage>& stage,
+                      std::vector<connection>& conns) {
+    conns.push_back(
+      m_sig.connect(
+        [stage](Args...args) {
+          (*stage)(std::forward<Args>(args)...);
+        }));
+    m_rest.connect_shared(stage, conns);
+  }
+
+private:
+  signal_type& m_sig;
+  merge_source<Rest...> m_rest;
+};
+
+} // namespace operators_detail
+
+// A pipeline of operators that will be connected to a source (one
+// signal or several merged signals).
+template<typename Source, typename Builder>
+class flow {
+public:
+  flow(Source source, Builder builder)
+    : m_source(std::move(source)),
+      m_builder(std::move(builder)) { }
+
+  template<typename Op>
+  flow<Source, operators_detail::compose_builder<Builder, Op>>
+  operator|(Op op) const {
+    return flow<Source, operators_detail::compose_builder<Builder, Op>>(
+      m_source, { m_builder, std::move(op) });
+  }
+
+  // Connects the whole fused pipeline as just one slot to the
+  // source. Returns a connection for one signal or a vector of
+  // connections for merged signals.
+  template<typename F>
+  auto connect(F&& f)
+    -> decltype(std::declval<Source&>().connect(
+                  std::declval<Builder&>()(
+                    operators_detail::sink_stage<typename std::decay<F>::type>{ std::forward<F>(f) }))) {
+    return m_source.connect(
+      m_builder(
+        operators_detail::sink_stage<typename std::decay<F>::type>{ std::forward<F>(f) }));
+  }
+
+private:
+  Source m_source;
+  Builder m_builder;
+};
+
+template<typename Signal>
+flow<operators_detail::signal_source<Signal>, operators_detail::identity_builder>
+from(Signal& sig) {
+  return { operators_detail::signal_source<Signal>(sig), {} };
+}
+
+template<typename...Signals>
+flow<operators_detail::merge_source<Signals...>, operators_detail::identity_builder>
+merge(Signals&...sigs) {
+  return { operators_detail::merge_source<Signals...>(sigs...), {} };
+}
+
+template<typename F>
+operators_detail::map_op<typename std::decay<F>::type> map(F&& f) {
+  return { std::forward<F>(f) };
+}
+
+template<typename P>
+operators_detail::filter_op<typename std::decay<P>::type> filter(P&& p) {
+  return { std::forward<P>(p) };
+}
+
+template<typename P>
+operators_detail::take_while_op<typename std::decay<P>::type> take_while(P&& p) {
+  return { std::forward<P>(p) };
+}
+
+inline operators_detail::throttle_op throttle(std::chrono::steady_clock::duration interval) {
+  return { interval };
+}
+
+} // namespace obs
+
+#endif
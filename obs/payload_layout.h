@@ -0,0 +1,74 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_PAYLOAD_LAYOUT_H_INCLUDED
+#define OBS_PAYLOAD_LAYOUT_H_INCLUDED
+#pragma once
+
+// Layout of signal arguments copied as raw bytes (a "payload"), used
+// by shm_signal<> and the journal. Each argument is placed at the
+// next offset aligned to its own alignment (offsets are constexpr so
+// they can be used to size local buffers).
+
+#include <cstddef>
+#include <type_traits>
+
+namespace obs {
+namespace payload_layout {
+
+template<typename...T>
+struct all_trivially_copyable : std::true_type { };
+
+template<typename T, typename...Rest>
+struct all_trivially_copyable<T, Rest...>
+  : std::integral_constant<bool,
+                           std::is_trivially_copyable<T>::value &&
+                           all_trivially_copyable<Rest...>::value> { };
+
+// Max alignment of the given types (1 if there are no types).
+template<typename...T>
+struct max_align : std::integral_constant<std::size_t, 1> { };
+
+template<typename T, typename...Rest>
+struct max_align<T, Rest...>
+  : std::integral_constant<std::size_t,
+                           (alignof(T) > max_align<Rest...>::value ?
+                            alignof(T): max_align<Rest...>::value)> { };
+
+constexpr std::size_t align_up(std::size_t v, std::size_t a) {
+  return (v + a - 1) & ~(a - 1);
+}
+
+// Returns the end offset of the given arguments starting from
+// "offset".
+template<typename...T>
+constexpr typename std::enable_if<sizeof...(T) == 0, std::size_t>::type
+payload_offset(std::size_t offset) {
+  return offset;
+}
+
+template<typename T, typename...Rest>
+constexpr std::size_t payload_offset(std::size_t offset) {
+  return payload_offset<Rest...>(align_up(offset, alignof(T)) + sizeof(T));
+}
+
+// Offset of the I-th argument.
+template<std::size_t I, typename T, typename...Rest>
+constexpr typename std::enable_if<I == 0, std::size_t>::type
+arg_offset(std::size_t offset) {
+  return align_up(offset, alignof(T));
+}
+
+template<std::size_t I, typename T, typename...Rest>
+constexpr typename std::enable_if<I != 0, std::size_t>::type
+arg_offset(std::size_t offset) {
+  return arg_offset<I-1, Rest...>(align_up(offset, alignof(T)) + sizeof(T));
+}
+
+} // namespace payload_layout
+} // namespace obs
+
+#endif
@@ -0,0 +1,36 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_PROBES_H_INCLUDED
+#define OBS_PROBES_H_INCLUDED
+#pragma once
+
+// USDT (user-level statically defined tracing) probes for
+// bpftrace/perf/systemtap, available when OBSERVABLE_USDT is defined
+// (see the OBSERVABLE_USDT option in CMakeLists.txt). Each probe is
+// just a nop instruction when it's not attached. E.g.
+//
+//   bpftrace -e 'usdt:./app:observable:erase_wait_end { @[tid] = count(); }'
+//
+// Available probes (provider "observable"):
+//
+//   connect(signal, slot)
+//   disconnect(signal, slot)
+//   emit_begin(signal)
+//   emit_end(signal)
+//   erase_wait_start(list)
+//   erase_wait_end(list)
+//
+#ifdef OBSERVABLE_USDT
+  #include <sys/sdt.h>
+  #define OBS_PROBE1(name, a)    DTRACE_PROBE1(observable, name, a)
+  #define OBS_PROBE2(name, a, b) DTRACE_PROBE2(observable, name, a, b)
+#else
+  #define OBS_PROBE1(name, a)    ((void)0)
+  #define OBS_PROBE2(name, a, b) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,285 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_QUEUED_SIGNAL_H_INCLUDED
+#define OBS_QUEUED_SIGNAL_H_INCLUDED
+#pragma once
+
+// Signals delivered in the thread of an event loop (this header is
+// POSIX-only and is not included in obs.h).
+
+#include "obs/connection.h"
+#include "obs/indices.h"
+#include "obs/ring_queue.h"
+#include "obs/signal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+  #include <sys/eventfd.h>
+#endif
+
+namespace obs {
+
+template<typename Callable>
+class queued_signal { };
+
+// A signal which can be emitted from any thread, but its slots are
+// called only from drain(). The emission just queues a copy of the
+// arguments.
+//
+// fd() is a file descriptor (an eventfd on Linux, or a pipe in other
+// systems) which is readable while there are queued events, so it can
+// be added to an existing epoll/poll/select loop. Only the emission
+// that finds the queue empty writes to the file descriptor, so there
+// is one syscall per batch of events (not per event). E.g.
+//
+//   obs::queued_signal<void(int)> sig;
+//   sig.connect([](int v){ ... });
+//
+//   epoll_event ev;
+//   ev.events = EPOLLIN;
+//   ev.data.ptr = &sig;
+//   epoll_ctl(epfd, EPOLL_CTL_ADD, sig.fd(), &ev);
+//   ...
+//   // When sig.fd() is readable:
+//   sig.drain(64);
+//
+// By default the queue is unbounded. A bounded queue (a preallocated
+// obs::ring_queue) can be created with a capacity and an overflow
+// policy for emissions when the queue is full (see obs::overflow).
+//
+template<typename...Args>
+class queued_signal<void(Args...)> {
+public:
+  using local_signal = signal<void(Args...)>;
+  using event = std::tuple<typename std::decay<Args>::type...>;
+
+  queued_signal() {
+    open_fd();
+  }
+
+  // Bounded queue with the given capacity (rounded to a power of two).
+  // Emissions don't allocate memory (if the arguments don't allocate
+  // memory when they are copied).
+  queued_signal(std::size_t capacity, overflow policy)
+    : m_ring(new ring_queue<event>(capacity, policy)) {
+    open_fd();
+  }
+
+  ~queued_signal() {
+    if (m_read_fd >= 0)
+      ::close(m_read_fd);
+    if (m_write_fd >= 0 && m_write_fd != m_read_fd)
+      ::close(m_write_fd);
+  }
+
+  queued_signal(const queued_signal&) = delete;
+  queued_signal& operator=(const queued_signal&) = delete;
+
+  // File descriptor to poll (readable when there are queued events).
+  int fd() const { return m_read_fd; }
+
+  // Capacity of the bounded queue (0 if it's unbounded).
+  std::size_t capacity() const { return (m_ring ? m_ring->capacity(): 0); }
+
+  // Counters of the bounded queue: events discarded by the overflow
+  // policy, and emissions that waited for space (overflow::block).
+  std::uint64_t dropped() const { return (m_ring ? m_ring->dropped(): 0); }
+  std::uint64_t waits() const { return (m_ring ? m_ring->waits(): 0); }
+
+  template<typename Function>
+  connection connect(Function&& f) {
+    return m_local.connect(std::forward<Function>(f));
+  }
+
+  template<class Class>
+  connection connect(void (Class::*m)(Args...args), Class* t) {
+    return m_local.connect(m, t);
+  }
+
+  // Queues the event. It can be called from any thread. In a bounded
+  // queue with overflow::block, it must not be called from the thread
+  // that drains the queue.
+  template<typename...Args2>
+  void operator()(Args2&&...args) {
+    if (m_ring) {
+      if (!m_ring->push(event(std::forward<Args2>(args)...)))
+        return;
+
+      // The event must be visible before we check the flag (see
+      // drain_ring()).
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!m_signaled.exchange(true))
+        signal_fd();
+      return;
+    }
+
+    bool notify;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.emplace_back(std::forward<Args2>(args)...);
+      notify = !m_signaled.exchange(true);
+    }
+    if (notify)
+      signal_fd();
+  }
+
+  // Calls the slots for at most "max" queued events (it doesn't block
+  // if there are no events). It's expected to be called from the
+  // event loop thread only. The file descriptor is readable again
+  // if there are events left in the queue. Returns the number of
+  // dispatched events.
+  std::size_t drain(std::size_t max = SIZE_MAX) {
+    if (m_ring)
+      return drain_ring(max);
+
+    // The buffer is reused between calls (a slot can call drain()
+    // recursively, in that case it uses a new buffer).
+    std::vector<event> batch;
+    batch.swap(m_batch);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      const std::size_t n = (max < m_queue.size() ? max: m_queue.size());
+      std::move(m_queue.begin(), m_queue.begin()+n, std::back_inserter(batch));
+      m_queue.erase(m_queue.begin(), m_queue.begin()+n);
+
+      // Reset the file descriptor only when the queue is empty (new
+      // events will signal it again). It's reset even if it wasn't
+      // signaled, because an emitter can write to the fd after we
+      // dispatched its event in a previous drain().
+      if (m_queue.empty()) {
+        m_signaled = false;
+        clear_fd();
+      }
+    }
+
+    for (auto& ev : batch)
+      call(ev, typename make_indices<sizeof...(Args)>::type());
+
+    const std::size_t n = batch.size();
+    batch.clear();
+    if (batch.capacity() > m_batch.capacity())
+      m_batch.swap(batch);
+    return n;
+  }
+
+  bool empty() const {
+    if (m_ring)
+      return m_ring->empty();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.empty();
+  }
+
+  std::size_t size() const {
+    if (m_ring)
+      return m_ring->size();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+  }
+
+private:
+  std::size_t drain_ring(std::size_t max) {
+    std::size_t n = 0;
+    event ev;
+    while (n < max && m_ring->try_pop(ev)) {
+      call(ev, typename make_indices<sizeof...(Args)>::type());
+      ++n;
+    }
+
+    if (m_ring->empty()) {
+      // Reset the fd before the flag, and check the queue again: an
+      // emitter that found the flag set before we reset it could have
+      // queued an event that we didn't see.
+      clear_fd();
+      m_signaled.store(false);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!m_ring->empty() && !m_signaled.exchange(true))
+        signal_fd();
+    }
+    return n;
+  }
+
+  void open_fd() {
+#ifdef __linux__
+    m_read_fd = m_write_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+    int fds[2];
+    if (::pipe(fds) == 0) {
+      for (int fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+      m_read_fd = fds[0];
+      m_write_fd = fds[1];
+    }
+#endif
+    assert(m_read_fd >= 0);
+  }
+
+  template<std::size_t...I>
+  void call(event& ev, indices<I...>) {
+    m_local(std::get<I>(ev)...);
+    (void)ev;
+  }
+
+  void signal_fd() {
+#ifdef __linux__
+    const std::uint64_t one = 1;
+#else
+    const char one = 1;
+#endif
+    ssize_t r;
+    do {
+      r = ::write(m_write_fd, &one, sizeof(one));
+    } while (r < 0 && errno == EINTR);
+  }
+
+  void clear_fd() {
+#ifdef __linux__
+    std::uint64_t value;
+    ssize_t r;
+    do {
+      r = ::read(m_read_fd, &value, sizeof(value));
+    } while (r < 0 && errno == EINTR);
+#else
+    char buf[64];
+    ssize_t r;
+    do {
+      r = ::read(m_read_fd, buf, sizeof(buf));
+    } while (r > 0 || (r < 0 && errno == EINTR));
+#endif
+  }
+
+  int m_read_fd = -1;
+  int m_write_fd = -1;
+  mutable std::mutex m_mutex;
+  std::deque<event> m_queue;
+  std::atomic<bool> m_signaled = { false }; // True if the fd was signaled and not cleared yet
+  std::vector<event> m_batch;   // Events being dispatched (reused buffer)
+  local_signal m_local;
+  std::unique_ptr<ring_queue<event>> m_ring; // Bounded queue (optional)
+};
+
+} // namespace obs
+
+#endif
@@ -0,0 +1,88 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_REENTRANCY_H_INCLUDED
+#define OBS_REENTRANCY_H_INCLUDED
+#pragma once
+
+#include <type_traits>
+
+namespace obs {
+
+// What a signal does when it's emitted again from one of its slots
+// (in the same thread).
+enum class reentrancy {
+  // Nested emissions are called recursively (default).
+  allow,
+
+  // Nested emissions deeper than the given max depth are skipped.
+  limit,
+
+  // Nested emissions are queued and emitted (in the same order)
+  // when the outermost emission finishes, so the stack doesn't grow.
+  // Signals with a result cannot defer emissions (nested emissions
+  // are skipped), and signals with non-copyable arguments are
+  // emitted recursively.
+  defer,
+};
+
+// True if all types can be copied (so emissions can be deferred).
+template<typename...T>
+struct all_copy_constructible : std::true_type { };
+
+template<typename T, typename...Rest>
+struct all_copy_constructible<T, Rest...>
+  : std::integral_constant<bool,
+                           std::is_copy_constructible<T>::value &&
+                           all_copy_constructible<Rest...>::value> { };
+
+// An emission of a signal (with a reentrancy mode != allow) which is
+// in progress in the current thread. Frames are linked from the
+// innermost to the outermost emission, and they live in the stack of
+// each emission.
+class reentrancy_frame {
+public:
+  explicit reentrancy_frame(const void* signal)
+    : m_signal(signal),
+      m_prev(top()) {
+    top() = this;
+  }
+
+  ~reentrancy_frame() {
+    top() = m_prev;
+  }
+
+  reentrancy_frame(const reentrancy_frame&) = delete;
+  reentrancy_frame& operator=(const reentrancy_frame&) = delete;
+
+  // Returns the outermost emission of the given signal in the
+  // current thread (or nullptr), and the number of emissions of
+  // the signal in progress in "depth".
+  static reentrancy_frame* find(const void* signal, int& depth) {
+    reentrancy_frame* outermost = nullptr;
+    depth = 0;
+    for (reentrancy_frame* f=top(); f; f=f->m_prev) {
+      if (f->m_signal == signal) {
+        outermost = f;
+        ++depth;
+      }
+    }
+    return outermost;
+  }
+
+private:
+  static reentrancy_frame*& top() {
+    static thread_local reentrancy_frame* frame = nullptr;
+    return frame;
+  }
+
+  const void* m_signal;
+  reentrancy_frame* m_prev;
+};
+
+} // namespace obs
+
+#endif
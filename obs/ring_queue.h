@@ -0,0 +1,261 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_RING_QUEUE_H_INCLUDED
+#define OBS_RING_QUEUE_H_INCLUDED
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace obs {
+
+// What a bounded queue does when it's full and a new element is
+// pushed.
+enum class overflow {
+  // The producer waits until there is space in the queue.
+  block,
+
+  // The new element is discarded.
+  drop_newest,
+
+  // The oldest element in the queue is discarded.
+  drop_oldest,
+
+  // The new element is kept in one extra place (replacing the
+  // previous element that overflowed), so only the latest element is
+  // kept while the queue is full. When the consumer frees space, the
+  // extra element is moved to the ring before the next pushed
+  // element, so elements are still popped in the same order they
+  // were pushed by each producer.
+  coalesce,
+};
+
+// Bounded multi-producer/multi-consumer queue on a preallocated ring
+// of elements (the capacity is rounded to a power of two). T must be
+// default constructible and move assignable.
+//
+// Pushing and popping elements is lock-free and doesn't allocate
+// memory while there is space in the queue. A mutex is used only in
+// the slow path: when a producer has to wait (overflow::block) or an
+// element is coalesced (overflow::coalesce, which allocates the extra
+// place the first time).
+template<typename T>
+class ring_queue {
+public:
+  explicit ring_queue(std::size_t capacity,
+                      overflow policy = overflow::block)
+    : m_policy(policy) {
+    std::size_t n = 2;
+    while (n < capacity)
+      n <<= 1;
+    m_mask = n-1;
+    m_cells.reset(new cell[n]);
+    for (std::size_t i=0; i<n; ++i)
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  ring_queue(const ring_queue&) = delete;
+  ring_queue& operator=(const ring_queue&) = delete;
+
+  std::size_t capacity() const { return m_mask+1; }
+  overflow policy() const { return m_policy; }
+
+  // Approximated number of elements in the queue (it can change at
+  // any time if other threads are using the queue).
+  std::size_t size() const {
+    const std::size_t deq = m_deq.load(std::memory_order_acquire);
+    const std::size_t enq = m_enq.load(std::memory_order_acquire);
+    return (enq > deq ? enq - deq: 0) +
+      (m_has_overflow.load(std::memory_order_acquire) ? 1: 0);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Number of elements discarded by the overflow policy (including
+  // coalesced elements that were replaced).
+  std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+  // Number of push() calls that had to wait (overflow::block).
+  std::uint64_t waits() const { return m_waits.load(std::memory_order_relaxed); }
+
+  // Pushes the element applying the overflow policy if the queue is
+  // full. Returns false if the element was discarded.
+  template<typename U>
+  bool push(U&& value) {
+    // Keep the order of the events of each producer: while there is
+    // a coalesced element, it must be moved to the ring before the
+    // new element.
+    if (m_policy == overflow::coalesce &&
+        m_has_overflow.load(std::memory_order_acquire))
+      return coalesce(std::forward<U>(value));
+
+    if (try_push(std::forward<U>(value)))
+      return true;
+
+    switch (m_policy) {
+
+      case overflow::block: {
+        m_waits.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiters.fetch_add(1, std::memory_order_seq_cst);
+        while (!try_push(std::forward<U>(value)))
+          m_cv.wait(lock);
+        m_waiters.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
+      }
+
+      case overflow::drop_newest:
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+
+      case overflow::drop_oldest: {
+        T oldest;
+        while (!try_push(std::forward<U>(value))) {
+          if (try_pop_ring(oldest))
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+      }
+
+      case overflow::coalesce:
+        return coalesce(std::forward<U>(value));
+    }
+    return false;
+  }
+
+  // Pushes the element only if there is space in the queue (it
+  // doesn't apply the overflow policy).
+  template<typename U>
+  bool try_push(U&& value) {
+    std::size_t pos = m_enq.load(std::memory_order_relaxed);
+    for (;;) {
+      cell& c = m_cells[pos & m_mask];
+      const std::size_t seq = c.seq.load(std::memory_order_acquire);
+      const std::intptr_t dif = std::intptr_t(seq) - std::intptr_t(pos);
+      if (dif == 0) {
+        if (m_enq.compare_exchange_weak(pos, pos+1,
+                                        std::memory_order_relaxed)) {
+          c.value = std::forward<U>(value);
+          c.seq.store(pos+1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (dif < 0)
+        return false;           // Full
+      else
+        pos = m_enq.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Pops the oldest element, returns false if the queue is empty.
+  bool try_pop(T& value) {
+    if (try_pop_ring(value)) {
+      wake_producers();
+      return true;
+    }
+
+    // The coalesced element is popped when the ring is empty.
+    if (m_has_overflow.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_has_overflow.load(std::memory_order_relaxed)) {
+        value = std::move(*m_overflow);
+        m_has_overflow.store(false, std::memory_order_release);
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct cell {
+    std::atomic<std::size_t> seq;
+    T value;
+  };
+
+  bool try_pop_ring(T& value) {
+    std::size_t pos = m_deq.load(std::memory_order_relaxed);
+    for (;;) {
+      cell& c = m_cells[pos & m_mask];
+      const std::size_t seq = c.seq.load(std::memory_order_acquire);
+      const std::intptr_t dif = std::intptr_t(seq) - std::intptr_t(pos+1);
+      if (dif == 0) {
+        if (m_deq.compare_exchange_weak(pos, pos+1,
+                                        std::memory_order_relaxed)) {
+          value = std::move(c.value);
+          c.seq.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (dif < 0)
+        return false;           // Empty
+      else
+        pos = m_deq.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Elements are coalesced only while the ring is full: if the
+  // consumer popped elements, the coalesced element goes back to the
+  // ring and the new element is pushed after it.
+  template<typename U>
+  bool coalesce(U&& value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_has_overflow.load(std::memory_order_relaxed) &&
+        try_push(std::move(*m_overflow)))
+      m_has_overflow.store(false, std::memory_order_release);
+
+    if (m_has_overflow.load(std::memory_order_relaxed)) {
+      *m_overflow = std::forward<U>(value);
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (!try_push(std::forward<U>(value))) {
+      if (!m_overflow)
+        m_overflow.reset(new T(std::forward<U>(value)));
+      else
+        *m_overflow = std::forward<U>(value);
+      m_has_overflow.store(true, std::memory_order_release);
+    }
+    return true;
+  }
+
+  // Wakes up producers waiting for space (overflow::block).
+  void wake_producers() {
+    if (m_policy != overflow::block)
+      return;
+
+    // The free cell must be visible before we check the waiters (a
+    // producer checks the cells after it's added to m_waiters).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_cv.notify_all();
+    }
+  }
+
+  std::unique_ptr<cell[]> m_cells;
+  std::size_t m_mask;
+  overflow m_policy;
+  std::atomic<std::size_t> m_enq = { 0 };
+  std::atomic<std::size_t> m_deq = { 0 };
+  std::atomic<std::uint64_t> m_dropped = { 0 };
+  std::atomic<std::uint64_t> m_waits = { 0 };
+
+  // Slow path (producers waiting for space, and coalesced element)
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::atomic<int> m_waiters = { 0 };
+  std::atomic<bool> m_has_overflow = { false };
+  std::unique_ptr<T> m_overflow;
+};
+
+} // namespace obs
+
+#endif
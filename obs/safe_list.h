@@ -8,6 +8,9 @@
 #define OBS_SAFE_LIST_H_INCLUDED
 #pragma once
 
+#include "obs/metrics.h"
+#include "obs/probes.h"
+
 #include <atomic>
 #include <cassert>
 #include <chrono>
@@ -15,6 +18,7 @@
 #include <iterator>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace obs {
 
@@ -42,6 +46,10 @@ private:
     // client have to check the return value from iterators).
     T* value;
 
+    // Value disabled with dispose_if(), it's released with the node in
+    // delete_nodes().
+    T* disposed = nullptr;
+
     // Number of locks for this node, it means the number of iterators
     // being used and currently pointing to this node.
     //
@@ -54,8 +62,8 @@ private:
 
     // Thread used to add the node to the list (i.e. the thread where
     // safe_list::push_back() was used). We suppose that the same
-    // thread will remove the node.
-    std::thread::id creator_thread;
+    // thread will remove the node. See thread_tag().
+    const void* creator_thread;
 
     // Pointer to the first iterator that locked this node in the same
     // thread it was created. It is used to unlock() the node when
@@ -64,7 +72,7 @@ private:
 
     node(T* value = nullptr)
       : value(value),
-        creator_thread(std::this_thread::get_id()) {
+        creator_thread(thread_tag()) {
     }
 
     node(const node&) = delete;
@@ -78,7 +86,7 @@ private:
     // a node belongs to the same "creator thread," so when we erase()
     // the node, we can (must) unlock all those iterators.
     bool in_creator_thread() const {
-      return (creator_thread == std::this_thread::get_id());
+      return (creator_thread == thread_tag());
     }
 
     // Locks the node by the given iterator. It means that
@@ -97,6 +105,15 @@ private:
     void unlock_all();
   };
 
+  // Identifies the current thread with the address of a thread-local
+  // variable (it's cheaper than std::this_thread::get_id()). Like
+  // thread IDs, an address can be reused by a new thread when other
+  // thread finishes.
+  static const void* thread_tag() {
+    static thread_local char tag;
+    return &tag;
+  }
+
   // Mutex used to modify the linked-list (m_first/m_last and node::next).
   mutable std::mutex m_mutex_nodes;
 
@@ -149,7 +166,8 @@ public:
 
     iterator(safe_list& list, node* node)
       : m_list(list),
-        m_node(node) {
+        m_node(node),
+        m_thread(thread_tag()) {
       m_list.ref();
 
       // Lock the node because this iterator is pointing to it.
@@ -164,7 +182,8 @@ public:
     // We can only move iterators
     iterator(iterator&& other)
       : m_list(other.m_list),
-        m_node(other.m_node) {
+        m_node(other.m_node),
+        m_thread(other.m_thread) {
       assert(!other.m_locked);
       m_list.ref();
     }
@@ -265,8 +284,13 @@ public:
     // True if this iterator has added a lock to the "m_node"
     bool m_locked = false;
 
-    // Next iterator locking the same "m_node" from its creator
-    // thread.
+    // Thread where this iterator is used (see thread_tag()), an
+    // iterator is never used from other threads.
+    const void* m_thread;
+
+    // Previous/next iterators locking the same "m_node" from its
+    // creator thread (a doubly linked list so unlock() is O(1)).
+    iterator* m_prev_iterator = nullptr;
     iterator* m_next_iterator = nullptr;
   };
 
@@ -298,6 +322,40 @@ public:
     }
   }
 
+  // Inserts the value before the first element "e" where
+  // less(value, e) is true, or at the end of the list. It's used to
+  // keep the list sorted at insertion time, so the iteration is still
+  // a linear walk. Iterators which already passed the insertion
+  // point will not see the new value.
+  template<typename Less>
+  void insert(T* value, Less less) {
+    node* n = new node(value);
+
+    std::lock_guard<std::mutex> lock(m_mutex_nodes);
+    if (!m_first) {
+      m_first = m_last = n;
+      return;
+    }
+
+    // Walk the list only if the value doesn't go at the end
+    if (!m_last->value || less(value, m_last->value)) {
+      node* prev = nullptr;
+      for (node* node=m_first; node; prev=node, node=node->next) {
+        if (node->value && less(value, node->value)) {
+          n->next = node;
+          if (prev)
+            prev->next = n;
+          else
+            m_first = n;
+          return;
+        }
+      }
+    }
+
+    m_last->next = n;
+    m_last = n;
+  }
+
   void erase(T* value) {
     // We add a ref to avoid calling delete_nodes().
     ref();
@@ -317,9 +375,17 @@ public:
           // because after erase() the client could be deleting the
           // value that we are using in other thread.
           if (node->locks) {
+#ifdef OBSERVABLE_METRICS
+            auto t0 = metrics::clock::now();
+#endif
             // Wait until the node is completely unlocked by other
             // threads.
+            OBS_PROBE1(erase_wait_start, this);
             m_delete_cv.wait(lock, [node]{ return node->locks == 0; });
+            OBS_PROBE1(erase_wait_end, this);
+#ifdef OBSERVABLE_METRICS
+            global_metrics().add_erase_wait(metrics::elapsed(t0));
+#endif
           }
 
           assert(node->locks == 0);
@@ -334,6 +400,70 @@ public:
     unref();
   }
 
+  // Erases all values that match the given predicate locking the
+  // list and iterating it just once. Like erase(), it waits until
+  // the nodes are unlocked by other threads.
+  template<typename Pred>
+  void erase_if(Pred pred) {
+    ref();
+    {
+      std::unique_lock<std::mutex> lock(m_mutex_nodes);
+
+      std::vector<node*> locked;
+      for (node* node=m_first; node; node=node->next) {
+        if (node->value && pred(node->value)) {
+          node->unlock_all();
+          node->value = nullptr;
+          m_delete_nodes = true;
+          if (node->locks)
+            locked.push_back(node);
+        }
+      }
+
+      if (!locked.empty()) {
+#ifdef OBSERVABLE_METRICS
+        auto t0 = metrics::clock::now();
+#endif
+        OBS_PROBE1(erase_wait_start, this);
+        m_delete_cv.wait(lock, [&locked]{
+                                 for (auto node : locked)
+                                   if (node->locks)
+                                     return false;
+                                 return true;
+                               });
+        OBS_PROBE1(erase_wait_end, this);
+#ifdef OBSERVABLE_METRICS
+        global_metrics().add_erase_wait(metrics::elapsed(t0));
+#endif
+      }
+    }
+    unref();
+  }
+
+  // Erases and deletes all values that match the given predicate.
+  // Reference counted values (e.g. slots) are released instead, so
+  // they are not deleted while they are referenced (e.g. by a pending
+  // emission).
+  //
+  // Unlike erase(), this doesn't wait other threads to unlock the
+  // nodes: values are only disabled here and then released by
+  // delete_nodes() when the list is not iterated anymore.
+  template<typename Pred>
+  void dispose_if(Pred pred) {
+    ref();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex_nodes);
+      for (node* node=m_first; node; node=node->next) {
+        if (node->value && pred(node->value)) {
+          node->disposed = node->value;
+          node->value = nullptr;
+          m_delete_nodes = true;
+        }
+      }
+    }
+    unref();
+  }
+
   iterator begin() {
     std::lock_guard<std::mutex> lock(m_mutex_nodes);
     return iterator(*this, m_first);
@@ -360,6 +490,17 @@ public:
   }
 
 private:
+  // Releases reference counted values (slots), and deletes the rest.
+  template<typename U>
+  static auto dispose(U* value, int) -> decltype(value->release(), void()) {
+    value->release();
+  }
+
+  template<typename U>
+  static void dispose(U* value, long) {
+    delete value;
+  }
+
   // Deletes nodes from the list. If "all" is true, deletes all nodes,
   // if it's false, it deletes only nodes with value == nullptr, which
   // are nodes that were disabled
@@ -387,6 +528,8 @@ private:
         }
 
         assert(!node->locks);
+        if (node->disposed)
+          dispose(node->disposed, 0);
         delete node;
       }
       else {
@@ -407,8 +550,11 @@ void safe_list<T>::node::lock(iterator* it) {
   // If we are in the creator thread, we add this iterator in the
   // "creator thread iterators" linked-list so the iterator is
   // notified in case that the node is erased.
-  if (in_creator_thread()) {
+  if (creator_thread == it->m_thread) {
+    it->m_prev_iterator = nullptr;
     it->m_next_iterator = creator_thread_iterator;
+    if (creator_thread_iterator)
+      creator_thread_iterator->m_prev_iterator = it;
     creator_thread_iterator = it;
   }
 }
@@ -420,21 +566,16 @@ void safe_list<T>::node::unlock(iterator* it) {
   // In this case we are unlocking just one iterator, if we are in the
   // creator thread, we've to remove this iterator from the "creator
   // thread iterators" linked-list.
-  if (in_creator_thread()) {
-    iterator* prev = nullptr;
-    iterator* next = nullptr;
-    for (auto it2=creator_thread_iterator; it2; it2=next) {
-      next = it2->m_next_iterator;
-      if (it2 == it) {
-        if (prev)
-          prev->m_next_iterator = next;
-        else
-          creator_thread_iterator = next;
-
-        break;
-      }
-      prev = it2;
+  if (creator_thread == it->m_thread) {
+    if (it->m_prev_iterator)
+      it->m_prev_iterator->m_next_iterator = it->m_next_iterator;
+    else {
+      assert(creator_thread_iterator == it);
+      creator_thread_iterator = it->m_next_iterator;
     }
+    if (it->m_next_iterator)
+      it->m_next_iterator->m_prev_iterator = it->m_prev_iterator;
+    it->m_prev_iterator = it->m_next_iterator = nullptr;
   }
 
   assert(locks > 0);
@@ -450,8 +591,11 @@ void safe_list<T>::node::unlock_all() {
     // Notify to all iterators in the creator thread that they don't
     // have the node locked anymore. In this way we can continue the
     // erase() call.
-    for (auto it=creator_thread_iterator; it; it=it->m_next_iterator) {
+    iterator* next = nullptr;
+    for (auto it=creator_thread_iterator; it; it=next) {
+      next = it->m_next_iterator;
       it->notify_unlock(this);
+      it->m_prev_iterator = it->m_next_iterator = nullptr;
 
       assert(locks > 0);
       --locks;
@@ -0,0 +1,419 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_SHM_SIGNAL_H_INCLUDED
+#define OBS_SHM_SIGNAL_H_INCLUDED
+#pragma once
+
+// Signals between processes of the same host using a POSIX shared
+// memory segment (this header is not included in obs.h).
+
+#include "obs/connection.h"
+#include "obs/indices.h"
+#include "obs/payload_layout.h"
+#include "obs/signal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <time.h>
+#endif
+
+namespace obs {
+
+namespace shm_detail {
+
+// Sequence value of an entry that is being written.
+const std::uint64_t busy = UINT64_MAX;
+
+// Header of the shared memory segment, followed by the ring buffer
+// entries. Atomics must be lock-free to work between processes.
+struct header {
+  std::atomic<std::uint32_t> state;       // 0=uninitialized, 1=initializing, 2=ready
+  std::uint32_t payload_size;
+  std::uint64_t capacity;                 // Number of entries (power of two)
+  std::atomic<std::uint64_t> write_seq;   // Next sequence number to write
+  std::atomic<std::uint32_t> futex;       // Incremented in each emission
+  std::atomic<std::uint32_t> waiters;     // Processes/threads waiting in wait()
+};
+
+// Each entry is a "seq" value (sequence number + 1 of the event that
+// is stored in the entry, 0 if it's empty, or "busy" while it's being
+// written) followed by the payload (the signal arguments).
+struct entry {
+  std::atomic<std::uint64_t> seq;
+};
+
+const std::size_t entry_align = 16;
+
+inline std::size_t header_size() {
+  return payload_layout::align_up(sizeof(header), entry_align);
+}
+
+#ifdef __linux__
+inline void futex_wait(std::atomic<std::uint32_t>* addr, std::uint32_t value,
+                       std::chrono::nanoseconds timeout) {
+  timespec ts;
+  ts.tv_sec = time_t(timeout.count() / 1000000000);
+  ts.tv_nsec = long(timeout.count() % 1000000000);
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr),
+          FUTEX_WAIT, value, &ts, nullptr, 0);
+}
+
+inline void futex_wake_all(std::atomic<std::uint32_t>* addr) {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr),
+          FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#else
+// Without futexes waiters just poll the counter.
+inline void futex_wait(std::atomic<std::uint32_t>* addr, std::uint32_t value,
+                       std::chrono::nanoseconds timeout) {
+  auto end = std::chrono::steady_clock::now() + timeout;
+  while (addr->load() == value && std::chrono::steady_clock::now() < end)
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+inline void futex_wake_all(std::atomic<std::uint32_t>*) { }
+#endif
+
+} // namespace shm_detail
+
+template<typename Callable>
+class shm_signal { };
+
+// A signal which can be emitted from several processes, and its
+// slots are called in each process that connected them when the
+// process calls dispatch() (or wait_and_dispatch()).
+//
+// The emission writes the arguments in a ring buffer of the shared
+// memory segment and doesn't wait the readers (it only waits another
+// emitter that is writing the same entry). Each process reads the
+// events from its own position, so all processes see all events
+// emitted after they opened the signal. The arguments are copied from the
+// shared memory before calling the slots, so an event that is
+// overwritten while it's read is not dispatched with torn arguments
+// (it's counted as dropped).
+//
+// If a process is more than "capacity" events behind, the oldest
+// events are lost (they are counted in dropped()).
+//
+// E.g.
+//
+//   // Process A
+//   obs::shm_signal<void(int, double)> sig("/my_events");
+//   sig(1, 2.0);
+//
+//   // Process B
+//   obs::shm_signal<void(int, double)> sig("/my_events");
+//   obs::scoped_connection c = sig.connect([](int a, double b){ ... });
+//   while (running)
+//     sig.wait_and_dispatch(std::chrono::milliseconds(100));
+//
+template<typename...Args>
+class shm_signal<void(Args...)> {
+  static_assert(payload_layout::all_trivially_copyable<Args...>::value,
+                "shm_signal<> arguments must be trivially copyable");
+  static_assert(payload_layout::max_align<Args...>::value <= shm_detail::entry_align,
+                "shm_signal<> arguments cannot be over-aligned");
+  static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                "shm_signal<> needs lock-free atomics");
+
+public:
+  using local_signal = signal<void(const Args&...)>;
+
+  shm_signal() { }
+
+  // Opens (or creates) the shared memory segment with the given
+  // name (e.g. "/name"). Use is_open() to know if it was opened.
+  explicit shm_signal(const std::string& name, std::size_t capacity = 1024) {
+    open(name, capacity);
+  }
+
+  ~shm_signal() {
+    close();
+  }
+
+  shm_signal(const shm_signal&) = delete;
+  shm_signal& operator=(const shm_signal&) = delete;
+
+  // Returns false and sets errno if the segment cannot be opened or
+  // it was created with other arguments or capacity. The capacity is
+  // rounded up to a power of two.
+  bool open(const std::string& name, std::size_t capacity = 1024) {
+    close();
+
+    std::size_t cap = 1;
+    while (cap < capacity)
+      cap <<= 1;
+
+    const std::size_t size = shm_detail::header_size() + cap*entry_size();
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+      return false;
+
+    // Only the first process that opens the segment resizes it
+    // (ftruncate() fills it with zeros, so the header is in the
+    // "uninitialized" state).
+    struct stat st;
+    if (::fstat(fd, &st) < 0 ||
+        (st.st_size == 0 && ::ftruncate(fd, off_t(size)) < 0) ||
+        ::fstat(fd, &st) < 0) {
+      ::close(fd);
+      return false;
+    }
+    if (std::size_t(st.st_size) != size) {
+      ::close(fd);
+      errno = EINVAL;
+      return false;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+      return false;
+
+    m_addr = addr;
+    m_size = size;
+
+    shm_detail::header* h = hdr();
+    std::uint32_t expected = 0;
+    if (h->state.compare_exchange_strong(expected, 1)) {
+      h->payload_size = std::uint32_t(payload_size());
+      h->capacity = cap;
+      h->state.store(2, std::memory_order_release);
+    }
+    else {
+      while (h->state.load(std::memory_order_acquire) != 2)
+        std::this_thread::yield();
+    }
+
+    if (h->payload_size != payload_size() || h->capacity != cap) {
+      close();
+      errno = EINVAL;
+      return false;
+    }
+
+    m_mask = cap - 1;
+    m_read = h->write_seq.load(std::memory_order_acquire);
+    m_dropped = 0;
+    return true;
+  }
+
+  void close() {
+    if (m_addr) {
+      ::munmap(m_addr, m_size);
+      m_addr = nullptr;
+      m_size = 0;
+    }
+  }
+
+  bool is_open() const { return (m_addr != nullptr); }
+
+  // Removes the name of the shared memory segment (processes that
+  // already opened it can still use it).
+  static bool unlink(const std::string& name) {
+    return (::shm_unlink(name.c_str()) == 0);
+  }
+
+  template<typename Function>
+  connection connect(Function&& f) {
+    return m_local.connect(std::forward<Function>(f));
+  }
+
+  template<class Class>
+  connection connect(void (Class::*m)(Args...args), Class* t) {
+    return m_local.connect(
+      [=](const Args&...args) {
+        (t->*m)(args...);
+      });
+  }
+
+  // Writes the event in the shared memory and wakes up the waiting
+  // processes. Local slots are called in dispatch() as in other
+  // processes.
+  void operator()(const Args&...args) {
+    assert(is_open());
+    shm_detail::header* h = hdr();
+    const std::uint64_t seq = h->write_seq.fetch_add(1, std::memory_order_relaxed);
+    shm_detail::entry* e = entry_at(seq);
+
+    // Claims the entry, it can be busy by a writer of an event that
+    // is "capacity" events before or after this one (we wait it), or
+    // it can already contain a newer event (this event is lost, as
+    // it would be overwritten anyway).
+    std::uint64_t cur = e->seq.load(std::memory_order_relaxed);
+    for (;;) {
+      if (cur == shm_detail::busy) {
+        std::this_thread::yield();
+        cur = e->seq.load(std::memory_order_relaxed);
+      }
+      else if (cur > seq) {
+        break;
+      }
+      else if (e->seq.compare_exchange_weak(cur, shm_detail::busy,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        std::atomic_thread_fence(std::memory_order_release);
+        write_args(payload(e), typename make_indices<sizeof...(Args)>::type(), args...);
+        e->seq.store(seq+1, std::memory_order_release);
+        break;
+      }
+    }
+
+    h->futex.fetch_add(1);
+    if (h->waiters.load())
+      shm_detail::futex_wake_all(&h->futex);
+  }
+
+  // Calls the local slots for at most "max" pending events. Returns
+  // the number of dispatched events. It must be called from one
+  // thread at the same time.
+  std::size_t dispatch(std::size_t max = SIZE_MAX) {
+    assert(is_open());
+    shm_detail::header* h = hdr();
+    std::size_t n = 0;
+    while (n < max) {
+      shm_detail::entry* e = entry_at(m_read);
+      const std::uint64_t seq = e->seq.load(std::memory_order_acquire);
+
+      if (seq == m_read+1) {
+        // The copy is local to this event, so a slot can call
+        // dispatch() again without overwriting its own arguments.
+        buffer copy;
+        unsigned char* p = reinterpret_cast<unsigned char*>(&copy);
+        std::memcpy(p, payload(e), payload_size());
+
+        // The entry was overwritten while we were copying it, the
+        // copy can be torn.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (e->seq.load(std::memory_order_relaxed) != seq) {
+          ++m_dropped;
+          ++m_read;
+          continue;
+        }
+
+        ++m_read;
+        ++n;
+        read_args(p, typename make_indices<sizeof...(Args)>::type());
+      }
+      // Other processes emitted more than "capacity" events since our
+      // last dispatch, skip the overwritten events.
+      else if (h->write_seq.load(std::memory_order_acquire) - m_read > m_mask+1 ||
+               (seq != shm_detail::busy && seq > m_read+1)) {
+        const std::uint64_t next = h->write_seq.load(std::memory_order_acquire) - (m_mask+1);
+        if (next > m_read) {
+          m_dropped += next - m_read;
+          m_read = next;
+        }
+        else
+          break;
+      }
+      // The event is not written yet
+      else
+        break;
+    }
+    return n;
+  }
+
+  // Waits until there is at least one pending event or the timeout
+  // expires, and dispatches all the pending events.
+  template<typename Rep, typename Period>
+  std::size_t wait_and_dispatch(const std::chrono::duration<Rep, Period>& timeout) {
+    assert(is_open());
+    shm_detail::header* h = hdr();
+    h->waiters.fetch_add(1);
+    const std::uint32_t value = h->futex.load();
+    if (!pending())
+      shm_detail::futex_wait(&h->futex, value,
+                             std::chrono::duration_cast<std::chrono::nanoseconds>(timeout));
+    h->waiters.fetch_sub(1);
+    return dispatch();
+  }
+
+  // Returns true if there are events to dispatch.
+  bool pending() const {
+    assert(is_open());
+    return (hdr()->write_seq.load(std::memory_order_acquire) != m_read);
+  }
+
+  // Number of events lost by this process because it was too far
+  // behind the emitters.
+  std::uint64_t dropped() const { return m_dropped; }
+
+private:
+  static std::size_t payload_size() {
+    return payload_layout::payload_offset<Args...>(0);
+  }
+
+  // Storage for a copy of the payload of one event.
+  using buffer = typename std::aligned_storage<
+    (payload_layout::payload_offset<Args...>(0) ?
+     payload_layout::payload_offset<Args...>(0): 1),
+    payload_layout::max_align<Args...>::value>::type;
+
+  static std::size_t entry_size() {
+    return payload_layout::align_up(shm_detail::entry_align + payload_size(),
+                                    shm_detail::entry_align);
+  }
+
+  template<std::size_t...I>
+  static void write_args(unsigned char* p, indices<I...>, const Args&...args) {
+    int dummy[] = { 0, (std::memcpy(p + payload_layout::arg_offset<I, Args...>(0),
+                                    &args, sizeof(Args)), 0)... };
+    (void)dummy;
+    (void)p;
+  }
+
+  template<std::size_t...I>
+  void read_args(unsigned char* p, indices<I...>) {
+    m_local(*reinterpret_cast<const Args*>(p + payload_layout::arg_offset<I, Args...>(0))...);
+    (void)p;
+  }
+
+  shm_detail::header* hdr() const {
+    return static_cast<shm_detail::header*>(m_addr);
+  }
+
+  shm_detail::entry* entry_at(std::uint64_t seq) const {
+    return reinterpret_cast<shm_detail::entry*>(
+      static_cast<unsigned char*>(m_addr) + shm_detail::header_size() +
+      std::size_t(seq & m_mask) * entry_size());
+  }
+
+  static unsigned char* payload(shm_detail::entry* e) {
+    return reinterpret_cast<unsigned char*>(e) + shm_detail::entry_align;
+  }
+
+  void* m_addr = nullptr;
+  std::size_t m_size = 0;
+  std::uint64_t m_mask = 0;
+  std::uint64_t m_read = 0;
+  std::uint64_t m_dropped = 0;
+  local_signal m_local;
+};
+
+} // namespace obs
+
+#endif
@@ -9,11 +9,28 @@
 #pragma once
 
 #include "obs/connection.h"
+#include "obs/indices.h"
 #include "obs/lists.h"
+#include "obs/metrics.h"
+#include "obs/probes.h"
+#include "obs/reentrancy.h"
 #include "obs/slot.h"
+#include "obs/tracing.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace obs {
 
@@ -21,6 +38,9 @@ class signal_base {
 public:
   virtual ~signal_base() { }
   virtual void disconnect_slot(slot_base* slot) = 0;
+
+  // Disconnects all slots marked with set_pending_disconnect(true).
+  virtual void disconnect_pending_slots() = 0;
 };
 
 // Signal for any kind of functions
@@ -34,19 +54,79 @@ public:
   using slot_type = slot<R(Args...)>;
   using slot_list = List<slot_type>;
 
+  // Slots of an emission that were not called yet by emit_until()
+  // because the time budget was exhausted. The emission is completed
+  // calling resume() (e.g. in the next frame), or cancelled with
+  // reset(). It must be finished before the signal is destroyed.
+  class pending_emission {
+  public:
+    pending_emission() { }
+    ~pending_emission() { reset(); }
+
+    pending_emission(const pending_emission&) = delete;
+    pending_emission& operator=(const pending_emission&) = delete;
+
+    // True if there are slots to be called.
+    explicit operator bool() const { return !empty(); }
+    bool empty() const { return m_next == m_slots.size(); }
+
+    // Number of slots that were deferred (not called yet).
+    std::size_t remaining() const { return m_slots.size() - m_next; }
+
+    // Number of slots called by this emission so far.
+    std::size_t called() const { return m_called; }
+
+    // Cancels the emission (the remaining slots are not called).
+    void reset() {
+      for (std::size_t i=m_next; i<m_slots.size(); ++i)
+        m_slots[i]->release();
+      m_slots.clear();
+      m_next = 0;
+      m_args.reset();
+      if (m_signal) {
+        --m_signal->m_pending_emissions;
+        m_signal = nullptr;
+      }
+    }
+
+  private:
+    friend class signal;
+    using args_type = std::tuple<typename std::decay<Args>::type...>;
+
+    signal* m_signal = nullptr;
+    std::vector<slot_type*> m_slots; // Referenced slots of the emission
+    std::size_t m_next = 0;          // Next slot to call
+    std::size_t m_called = 0;
+    std::uint32_t m_version = 0;     // signal::m_version of m_slots
+    std::unique_ptr<args_type> m_args;
+  };
+
   signal() { }
   ~signal() {
-    for (auto slot : m_slots)
-      delete slot;
+    assert(m_pending_emissions == 0);
+    destroy_slots(m_slots);
   }
 
-  signal(const signal&) { }
-  signal& operator=(const signal&) { return *this; }
+  // Copies of a signal don't have slots, except with cow_list<> (see
+  // cow_signal) where the copy shares the slots of the other signal.
+  signal(const signal& other) {
+    copy_slots(m_slots, other.m_slots);
+  }
+  signal& operator=(const signal& other) {
+    if (this != &other)
+      copy_slots(m_slots, other.m_slots);
+    return *this;
+  }
 
   operator bool() const { return !m_slots.empty(); }
 
+  // The list of slots is sorted by priority when a slot is added, so
+  // the emission is just a linear walk.
   connection add_slot(slot_type* s) {
-    m_slots.push_back(s);
+    OBS_PROBE2(connect, this, s);
+    m_slots.insert(s, [](const slot_type* a, const slot_type* b) {
+                        return a->priority() > b->priority();
+                      });
     return connection(this, s);
   }
 
@@ -63,30 +143,541 @@ public:
                       }));
   }
 
+  // Slots with higher priority are called first, slots with the
+  // same priority are called in the same order they were connected
+  // (by default all slots have priority 0).
+  template<typename Function>
+  connection connect(int priority, Function&& f) {
+    slot_type* s = new slot_type(std::forward<Function>(f));
+    s->set_priority(priority);
+    return add_slot(s);
+  }
+
+  template<class Class>
+  connection connect(int priority, result_type (Class::*m)(Args...args), Class* t) {
+    return connect(priority,
+                   [=](Args...args) -> result_type {
+                     return (t->*m)(std::forward<Args>(args)...);
+                   });
+  }
+
+  // Connects a slot which is called only while "owner" is alive.
+  // It's disconnected and deleted automatically in the first signal
+  // emission after the owner is destroyed (there is no need to keep
+  // the connection), but the connection can be used to block or
+  // disconnect the slot before that.
+  template<typename Owner, typename Function>
+  connection connect(const std::weak_ptr<Owner>& owner, Function&& f) {
+    slot_type* s = new slot_type(std::forward<Function>(f));
+    s->track(owner);
+    return add_slot(s);
+  }
+
+  template<typename Owner, typename Function>
+  connection connect(const std::shared_ptr<Owner>& owner, Function&& f) {
+    return connect(std::weak_ptr<Owner>(owner), std::forward<Function>(f));
+  }
+
+  template<class Class>
+  connection connect(result_type (Class::*m)(Args...args), const std::shared_ptr<Class>& t) {
+    Class* p = t.get();
+    return connect(std::weak_ptr<Class>(t),
+                   [=](Args...args) -> result_type {
+                     return (p->*m)(std::forward<Args>(args)...);
+                   });
+  }
+
   virtual void disconnect_slot(slot_base* slot) override {
+    OBS_PROBE2(disconnect, this, slot);
     m_slots.erase(static_cast<slot_type*>(slot));
+    m_version.fetch_add(1, std::memory_order_release);
+  }
+
+  virtual void disconnect_pending_slots() override {
+    m_slots.erase_if(
+      [this](slot_type* s) {
+        if (!s->pending_disconnect())
+          return false;
+        OBS_PROBE2(disconnect, this, s);
+        s->set_pending_disconnect(false);
+        return true;
+      });
+    m_version.fetch_add(1, std::memory_order_release);
   }
 
   template<typename U = R, typename...Args2>
   typename std::enable_if<std::is_void<U>::value, void>::type
   operator()(Args2&&...args) {
-    for (auto slot : iterate_list(m_slots))
-      if (slot)
-        (*slot)(std::forward<Args2>(args)...);
+    if (m_reentrancy != reentrancy::allow) {
+      emit_reentrant(std::forward<Args2>(args)...);
+      return;
+    }
+    emit([&](slot_type* slot) {
+           (*slot)(std::forward<Args2>(args)...);
+         });
   }
 
   template<typename U = R, typename...Args2>
   typename std::enable_if<!std::is_void<U>::value, U>::type
   operator()(Args2&&...args) {
     U result = {};
-    for (auto slot : iterate_list(m_slots))
-      if (slot)
-        result = (*slot)(std::forward<Args2>(args)...);
+    if (m_reentrancy != reentrancy::allow) {
+      // Emissions with a result cannot be deferred, so the "defer"
+      // mode is like "limit" with max depth = 1.
+      int depth;
+      reentrancy_frame::find(this, depth);
+      if (depth >= (m_reentrancy == reentrancy::defer ? 1: m_max_depth)) {
+        ++m_skipped;
+        return result;
+      }
+      deferred_frame<std::tuple<>> frame(this);
+      emit([&](slot_type* slot) {
+             result = (*slot)(std::forward<Args2>(args)...);
+           });
+      return result;
+    }
+    emit([&](slot_type* slot) {
+           result = (*slot)(std::forward<Args2>(args)...);
+         });
     return result;
   }
 
+  // Calls all slots in parallel and reduces their results with
+  // combine(a, b), which must be associative (e.g. a sum or a max).
+  // "executor" is called with functions (void()) that must be run in
+  // other threads (e.g. posting them to a thread pool), the calling
+  // thread runs one of them too and waits the others.
+  //
+  // Slots are split in contiguous groups and the partial results
+  // are combined in the same order of the slots, so the result is
+  // deterministic. If there are less slots than min_parallel_slots()
+  // the slots are called serially in the calling thread. Slots must
+  // be thread-safe, and the arguments are shared by all threads.
+  template<typename Executor, typename Combiner, typename...Args2,
+           typename U = R>
+  typename std::enable_if<!std::is_void<U>::value, U>::type
+  emit_reduce(Executor&& executor, Combiner&& combine, Args2&&...args) {
+    OBS_PROBE1(emit_begin, this);
+#ifdef OBSERVABLE_METRICS
+    auto t0 = m_metrics.begin_emit();
+#endif
+    // Each slot is referenced (and its owner is locked) so it can be
+    // disconnected from other threads while it's called.
+    std::vector<slot_type*> slots;
+    std::vector<std::shared_ptr<void>> owners;
+    bool expired = false;
+    for (auto slot : iterate_list(m_slots)) {
+      if (!slot || slot->blocked())
+        continue;
+
+      std::shared_ptr<void> owner;
+      if (slot->tracked() && !(owner = slot->lock_owner())) {
+        expired = true;
+        continue;
+      }
+      slot->add_ref();
+      slots.push_back(slot);
+      if (owner)
+        owners.push_back(std::move(owner));
+    }
+    if (expired)
+      dispose_expired_slots();
+
+    const std::size_t n = slots.size();
+    U result = {};
+
+    // Reduces the results of the slots in [first, last)
+    auto reduce = [&](std::size_t first, std::size_t last) -> U {
+      U r = (*slots[first])(args...);
+      for (std::size_t i=first+1; i<last; ++i)
+        r = combine(std::move(r), (*slots[i])(args...));
+      return r;
+    };
+
+    if (n > 0 && n < m_min_parallel) {
+      result = reduce(0, n);
+    }
+    else if (n > 0) {
+      const std::size_t k =
+        std::min<std::size_t>(n, std::max(2u, std::thread::hardware_concurrency()));
+      std::vector<U> partial(k);
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::size_t pending = k-1;
+
+      for (std::size_t c=1; c<k; ++c) {
+        executor([&, c]{
+                   partial[c] = reduce(c*n/k, (c+1)*n/k);
+                   std::lock_guard<std::mutex> lock(mutex);
+                   if (--pending == 0)
+                     cv.notify_one();
+                 });
+      }
+      partial[0] = reduce(0, n/k);
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&pending]{ return pending == 0; });
+      }
+
+      result = std::move(partial[0]);
+      for (std::size_t c=1; c<k; ++c)
+        result = combine(std::move(result), std::move(partial[c]));
+    }
+
+    for (auto slot : slots)
+      slot->release();
+#ifdef OBSERVABLE_METRICS
+    m_metrics.end_emit(t0, n);
+#endif
+    OBS_PROBE1(emit_end, this);
+    return result;
+  }
+
+  // Calls the slots until the given deadline is reached (at least one
+  // slot is called), the rest of the slots are kept in "pending" to
+  // be called with resume(). Returns the number of deferred slots.
+  //
+  // The emission calls only the slots that were connected when it
+  // started: slots connected later are not called, and slots
+  // disconnected (or blocked) before their turn are skipped. The
+  // arguments are copied to be used in resume(). "pending" must be
+  // empty (a finished or cancelled emission).
+  //
+  //   obs::signal<void(int)>::pending_emission pending;
+  //   sig.emit_until(pending, frame_deadline, value);
+  //   ...
+  //   // Next frame
+  //   if (pending)
+  //     sig.resume(pending, frame_deadline);
+  //
+  template<typename Clock, typename Duration, typename...Args2,
+           typename U = R>
+  typename std::enable_if<std::is_void<U>::value, std::size_t>::type
+  emit_until(pending_emission& pending,
+             const std::chrono::time_point<Clock, Duration>& deadline,
+             Args2&&...args) {
+    assert(!pending);
+    pending.reset();
+    pending.m_signal = this;
+    ++m_pending_emissions;
+    pending.m_called = 0;
+    pending.m_version = m_version.load(std::memory_order_acquire);
+    pending.m_args.reset(
+      new typename pending_emission::args_type(std::forward<Args2>(args)...));
+
+    for (auto slot : iterate_list(m_slots)) {
+      if (slot) {
+        slot->add_ref();
+        pending.m_slots.push_back(slot);
+      }
+    }
+    return resume(pending, deadline);
+  }
+
+  // Continues the emission until the deadline, returns the number of
+  // slots that are still deferred (0 when the emission is finished).
+  template<typename Clock, typename Duration>
+  std::size_t resume(pending_emission& pending,
+                     const std::chrono::time_point<Clock, Duration>& deadline) {
+    if (!pending) {
+      pending.reset();
+      return 0;
+    }
+    assert(pending.m_signal == this);
+
+    OBS_PROBE1(emit_begin, this);
+#ifdef OBSERVABLE_METRICS
+    auto t0 = m_metrics.begin_emit();
+    std::uint64_t calls = 0;
+#endif
+    bool expired = false;
+    do {
+      if (pending.m_version != m_version.load(std::memory_order_acquire)) {
+        remove_disconnected(pending);
+        if (!pending)
+          break;
+      }
+
+      slot_type* slot = pending.m_slots[pending.m_next++];
+      if (!slot->blocked()) {
+        std::shared_ptr<void> owner;
+        if (slot->tracked() && !(owner = slot->lock_owner()))
+          expired = true;
+        else {
+          call_tuple(slot, *pending.m_args,
+                     typename make_indices<sizeof...(Args)>::type());
+          ++pending.m_called;
+#ifdef OBSERVABLE_METRICS
+          ++calls;
+#endif
+        }
+      }
+      slot->release();
+    } while (pending && Clock::now() < deadline);
+
+    if (expired)
+      dispose_expired_slots();
+    if (!pending)
+      pending.reset();
+#ifdef OBSERVABLE_METRICS
+    m_metrics.end_emit(t0, calls);
+#endif
+    OBS_PROBE1(emit_end, this);
+    return pending.remaining();
+  }
+
+  // Min number of slots to call them in parallel in emit_reduce().
+  void set_min_parallel_slots(std::size_t n) { m_min_parallel = n; }
+  std::size_t min_parallel_slots() const { return m_min_parallel; }
+
+  // Changes what happens when the signal is emitted from its own
+  // slots in the same thread (see obs::reentrancy). "max_depth" is
+  // the max number of nested emissions in reentrancy::limit mode
+  // (including the outermost one). It must be called when the
+  // signal is not being emitted.
+  void set_reentrancy(reentrancy mode, int max_depth = 1) {
+    m_reentrancy = mode;
+    m_max_depth = max_depth;
+  }
+
+  reentrancy reentrancy_mode() const { return m_reentrancy; }
+
+  // Number of nested emissions that were queued (reentrancy::defer)
+  // or skipped (reentrancy::limit).
+  std::uint64_t deferred_emissions() const { return m_deferred; }
+  std::uint64_t skipped_emissions() const { return m_skipped; }
+
+  // Names this instance to be identified in obs::report_metrics()
+  // and traces. It does nothing if OBSERVABLE_METRICS or
+  // OBSERVABLE_TRACING are not defined.
+  void set_name(const char* name) {
+#ifdef OBSERVABLE_METRICS
+    m_metrics.set_name(name);
+#endif
+#ifdef OBSERVABLE_TRACING
+    tracing::set_name(this, name);
+#endif
+    (void)name;
+  }
+
+#ifdef OBSERVABLE_METRICS
+  // Emission counters and times of this signal.
+  obs::metrics& metrics() { return m_metrics; }
+  const obs::metrics& metrics() const { return m_metrics; }
+#endif
+
 protected:
+  // Emissions can be deferred only if a copy of the arguments can
+  // be queued. It's a template to check the arguments when the
+  // signal is emitted (they can be incomplete types in the signal
+  // declaration).
+  template<typename Dummy = void>
+  struct deferral {
+    static constexpr bool enabled =
+      all_copy_constructible<typename std::decay<Args>::type...>::value;
+    using tag = std::integral_constant<bool, enabled>;
+    using item = typename std::conditional<
+      enabled,
+      std::tuple<typename std::decay<Args>::type...>,
+      std::tuple<>>::type;
+  };
+
+  // Emission in progress of this signal in the current thread, it
+  // keeps the queue of nested emissions in reentrancy::defer mode.
+  template<typename Item>
+  struct deferred_frame : reentrancy_frame {
+    explicit deferred_frame(const signal* sig) : reentrancy_frame(sig) { }
+    std::vector<Item> queue;
+  };
+
+  template<typename...Args2>
+  void emit_reentrant(Args2&&...args) {
+    using d = deferral<>;
+    int depth;
+    reentrancy_frame* outermost = reentrancy_frame::find(this, depth);
+
+    if (m_reentrancy == reentrancy::defer && d::enabled) {
+      if (outermost) {
+        enqueue(typename d::tag(), outermost, std::forward<Args2>(args)...);
+        ++m_deferred;
+        return;
+      }
+    }
+    else if (m_reentrancy == reentrancy::limit && depth >= m_max_depth) {
+      ++m_skipped;
+      return;
+    }
+
+    deferred_frame<typename d::item> frame(this);
+    emit([&](slot_type* slot) {
+           (*slot)(std::forward<Args2>(args)...);
+         });
+    emit_queued(typename d::tag(), frame);
+  }
+
+  template<typename...Args2>
+  void enqueue(std::true_type, reentrancy_frame* outermost, Args2&&...args) {
+    static_cast<deferred_frame<typename deferral<>::item>*>(outermost)
+      ->queue.emplace_back(std::forward<Args2>(args)...);
+  }
+
+  template<typename...Args2>
+  void enqueue(std::false_type, reentrancy_frame*, Args2&&...) { }
+
+  // Emits the queued emissions (slots can queue more).
+  template<typename Frame>
+  void emit_queued(std::true_type, Frame& frame) {
+    for (std::size_t i=0; i<frame.queue.size(); ++i) {
+      typename deferral<>::item a = std::move(frame.queue[i]);
+      emit_tuple(a, typename make_indices<sizeof...(Args)>::type());
+    }
+  }
+
+  template<typename Frame>
+  void emit_queued(std::false_type, Frame&) { }
+
+  template<typename Tuple, std::size_t...I>
+  void emit_tuple(Tuple& a, indices<I...>) {
+    emit([&](slot_type* slot) {
+           (*slot)(std::get<I>(a)...);
+         });
+    (void)a;
+  }
+
+  // Calls all slots with the given "call" function (which calls the
+  // slot with the signal arguments).
+  template<typename Call>
+  void emit(Call&& call) {
+    OBS_PROBE1(emit_begin, this);
+#ifdef OBSERVABLE_METRICS
+    auto t0 = m_metrics.begin_emit();
+    std::uint64_t calls = 0;
+#endif
+#ifdef OBSERVABLE_TRACING
+    const bool traced = tracing::enabled();
+    if (traced)
+      tracing::add(tracing::event::emit_begin, this);
+#endif
+    bool expired = false;
+    for (auto slot : iterate_list(m_slots)) {
+      if (!slot || slot->blocked())
+        continue;
+
+      std::shared_ptr<void> owner;
+      if (slot->tracked() && !(owner = slot->lock_owner())) {
+        expired = true;
+        continue;
+      }
+
+#ifdef OBSERVABLE_TRACING
+      if (traced)
+        tracing::add(tracing::event::slot_begin, slot);
+#endif
+      call(slot);
+#ifdef OBSERVABLE_TRACING
+      if (traced)
+        tracing::add(tracing::event::slot_end, slot);
+#endif
+#ifdef OBSERVABLE_METRICS
+      ++calls;
+#endif
+    }
+    if (expired)
+      dispose_expired_slots();
+#ifdef OBSERVABLE_TRACING
+    if (traced)
+      tracing::add(tracing::event::emit_end, this);
+#endif
+#ifdef OBSERVABLE_METRICS
+    m_metrics.end_emit(t0, calls);
+#endif
+    OBS_PROBE1(emit_end, this);
+  }
+
+  template<typename L>
+  void destroy_slots(L& slots) {
+    for (auto slot : slots)
+      delete slot;
+  }
+
+  // Slots in a cow_list<> are deleted with the last list that
+  // references them, here we just invalidate the connections to this
+  // signal.
+  template<typename T>
+  void destroy_slots(cow_list<T>& slots) {
+    for (auto slot : slots) {
+      if (slot_table::signal_of(slot->handle()) == this)
+        slot->reset_handle();
+    }
+  }
+
+  template<typename L>
+  void copy_slots(L&, const L&) { }
+
+  template<typename T>
+  void copy_slots(cow_list<T>& slots, const cow_list<T>& other) {
+    destroy_slots(slots);
+    slots = other;
+  }
+
+  // Removes all slots whose tracked object was destroyed in just
+  // one pass of the list.
+  void dispose_expired_slots() {
+    // Connections to expired slots are invalidated here, so they
+    // cannot release the slot again (e.g. if it's still referenced
+    // by a pending emission).
+    m_slots.dispose_if([](slot_type* s){
+                         if (!s->expired())
+                           return false;
+                         s->reset_handle();
+                         return true;
+                       });
+    m_version.fetch_add(1, std::memory_order_release);
+  }
+
+  template<std::size_t...I>
+  void call_tuple(slot_type* slot,
+                  typename pending_emission::args_type& a,
+                  indices<I...>) {
+    (*slot)(std::get<I>(a)...);
+    (void)a;
+  }
+
+  // Removes from the pending emission the slots that were
+  // disconnected since it was started (or since the last check).
+  void remove_disconnected(pending_emission& pending) {
+    pending.m_version = m_version.load(std::memory_order_acquire);
+
+    std::vector<slot_type*> current;
+    for (auto slot : iterate_list(m_slots)) {
+      if (slot)
+        current.push_back(slot);
+    }
+    std::sort(current.begin(), current.end());
+
+    auto first = pending.m_slots.begin() + pending.m_next;
+    auto it = std::remove_if(
+      first, pending.m_slots.end(),
+      [&current](slot_type* slot) {
+        if (std::binary_search(current.begin(), current.end(), slot))
+          return false;
+        slot->release();
+        return true;
+      });
+    pending.m_slots.erase(it, pending.m_slots.end());
+  }
+
   slot_list m_slots;
+  reentrancy m_reentrancy = reentrancy::allow;
+  int m_max_depth = 1;
+  std::size_t m_min_parallel = 8;
+  std::atomic<std::uint32_t> m_version = { 0 }; // Incremented when slots are disconnected
+  int m_pending_emissions = 0;
+  std::atomic<std::uint64_t> m_deferred = { 0 };
+  std::atomic<std::uint64_t> m_skipped = { 0 };
+#ifdef OBSERVABLE_METRICS
+  obs::metrics m_metrics;
+#endif
 };
 
 template<typename Callable>
@@ -95,6 +686,12 @@ using fast_signal = signal<Callable, fast_list>;
 template<typename Callable>
 using safe_signal = signal<Callable, safe_list>;
 
+// A signal whose copies share its slots until a slot is connected or
+// disconnected from the copy (or from the original signal), so
+// copying a heavily-connected signal is O(1).
+template<typename Callable>
+using cow_signal = signal<Callable, cow_list>;
+
 } // namespace obs
 
 #endif
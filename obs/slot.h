@@ -8,26 +8,195 @@
 #define OBS_SLOT_H_INCLUDED
 #pragma once
 
+#include "obs/connection.h"
+#include "obs/indices.h"
+
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace obs {
 
 template<typename T>
 struct is_callable_without_args : std::is_convertible<T, std::function<void()>> { };
 
+// True if F can be called with the arguments of Args... in the
+// given indices.
+template<typename F, typename Indices, typename...Args>
+struct is_callable_with_indices { };
+
+template<typename F, std::size_t...I, typename...Args>
+struct is_callable_with_indices<F, indices<I...>, Args...> {
+  template<typename G>
+  static auto test(int) -> decltype(
+    std::declval<G&>()(
+      std::declval<typename std::tuple_element<I, std::tuple<Args...>>::type>()...),
+    std::true_type());
+
+  template<typename G>
+  static std::false_type test(...);
+
+  static constexpr bool value = decltype(test<F>(0))::value;
+};
+
+// Number of leading arguments of Args... that F can be called with
+// (the longest prefix is used), or -1 if it cannot be called with
+// any prefix.
+template<typename F, int N, typename...Args>
+struct prefix_arity
+  : std::conditional<
+      is_callable_with_indices<F, typename make_indices<std::size_t(N)>::type, Args...>::value,
+      std::integral_constant<int, N>,
+      prefix_arity<F, N-1, Args...>>::type { };
+
+template<typename F, typename...Args>
+struct prefix_arity<F, -1, Args...> : std::integral_constant<int, -1> { };
+
+// True if F must be called with a prefix of Args... (it cannot be
+// called with all the arguments, but it can be called with the
+// first N arguments).
+template<typename F, typename...Args>
+struct needs_prefix_args {
+  static constexpr int arity =
+    prefix_arity<typename std::decay<F>::type, int(sizeof...(Args)), Args...>::value;
+  static constexpr bool value = (arity >= 0 && arity < int(sizeof...(Args)));
+};
+
+// Function object that calls F with the first arguments (in the
+// given indices) and ignores the rest. It's stored directly in the
+// std::function of the slot (there is no other type erasure), so
+// after inlining it costs the same as a slot with the exact
+// signature.
+template<typename F, typename Indices>
+class prefix_args_adapter { };
+
+template<typename F, std::size_t...I>
+class prefix_args_adapter<F, indices<I...>> {
+public:
+  template<typename G>
+  explicit prefix_args_adapter(G&& g) : m_f(std::forward<G>(g)) { }
+
+  template<typename...Args>
+  auto operator()(Args&&...args)
+    -> decltype(std::declval<F&>()(
+                  std::declval<typename std::tuple_element<I, std::tuple<Args&&...>>::type>()...)) {
+    std::tuple<Args&&...> t(std::forward<Args>(args)...);
+    (void)t;
+    return m_f(std::get<I>(std::move(t))...);
+  }
+
+private:
+  F m_f;
+};
+
+// Adapts F to be called with Args... (see slot<>).
+template<typename F, typename...Args>
+prefix_args_adapter<typename std::decay<F>::type,
+                    typename make_indices<std::size_t(needs_prefix_args<F, Args...>::arity)>::type>
+adapt_prefix_args(F&& f) {
+  return prefix_args_adapter<
+    typename std::decay<F>::type,
+    typename make_indices<std::size_t(needs_prefix_args<F, Args...>::arity)>::type>(
+      std::forward<F>(f));
+}
+
 class slot_base {
 public:
   slot_base() { }
-  virtual ~slot_base() { }
+  virtual ~slot_base() {
+    reset_handle();
+  }
 
   // Disable copy
   slot_base(const slot_base&) = delete;
   slot_base& operator=(const slot_base&) = delete;
+
+  // Ties the lifetime of this slot to the given object, the slot
+  // is not called anymore when the object is destroyed.
+  void track(const std::weak_ptr<void>& owner) {
+    m_owner = owner;
+    m_tracked = true;
+  }
+
+  bool tracked() const { return m_tracked; }
+  bool expired() const { return m_tracked && m_owner.expired(); }
+
+  // Returns a reference to the tracked object to keep it alive while
+  // the slot is being called (or nullptr if it was destroyed).
+  std::shared_ptr<void> lock_owner() const { return m_owner.lock(); }
+
+  // Slots with higher priority are called first by the signal.
+  void set_priority(int priority) { m_priority = priority; }
+  int priority() const { return m_priority; }
+
+  // A blocked slot is not called in signal emissions (but it's still
+  // connected). Blocks are counted, so the slot is unblocked when
+  // block() and unblock() were called the same number of times.
+  void block() { ++m_blocks; }
+  void unblock() {
+    int v = m_blocks.load();
+    while (v > 0 && !m_blocks.compare_exchange_weak(v, v-1))
+      ;
+  }
+  bool blocked() const {
+    return (m_blocks.load(std::memory_order_acquire) != 0);
+  }
+
+  // Used by connection_group to disconnect several slots of the same
+  // signal in just one pass.
+  void set_pending_disconnect(bool state) { m_pending_disconnect = state; }
+  bool pending_disconnect() const { return m_pending_disconnect; }
+
+  // Index of the slot_table entry of this slot (0 if it's not
+  // referenced by connection handles).
+  void set_handle(std::uint32_t index) {
+    m_handle.store(index, std::memory_order_release);
+  }
+  std::uint32_t handle() const {
+    return m_handle.load(std::memory_order_acquire);
+  }
+
+  // Invalidates the connection handles to this slot. A slot shared by
+  // copies of a cow_signal can be reset from several threads at the
+  // same time, only one of them removes the slot_table entry.
+  void reset_handle() {
+    const std::uint32_t index = m_handle.exchange(0, std::memory_order_acq_rel);
+    if (index)
+      slot_table::remove(index);
+  }
+
+  // Slots are reference counted so they can be shared by several
+  // signals (see obs::cow_list). A new slot has one reference.
+  void add_ref() { m_refs.fetch_add(1, std::memory_order_relaxed); }
+
+  // Deletes the slot if this was the last reference. If there is
+  // only one reference no other list can add a new one, so we can
+  // avoid the atomic decrement.
+  void release() {
+    if (m_refs.load(std::memory_order_acquire) == 1 ||
+        m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete this;
+  }
+
+private:
+  std::weak_ptr<void> m_owner;
+  bool m_tracked = false;
+  int m_priority = 0;
+  bool m_pending_disconnect = false;
+  std::atomic<int> m_blocks = { 0 };
+  std::atomic<std::uint32_t> m_handle = { 0 };
+  std::atomic<int> m_refs = { 1 };
 };
 
-// Generic slot
+// Generic slot. The function can receive all the arguments, or just
+// the first ones (e.g. a slot of signal<void(int, double)> can be a
+// function(), function(int), or function(int, double)).
 template<typename Callable>
 class slot { };
 
@@ -35,14 +204,12 @@ template<typename R, typename...Args>
 class slot<R(Args...)> : public slot_base {
 public:
   template<typename F,
-           typename = typename std::enable_if<(sizeof...(Args) == 0 ||
-                                               !is_callable_without_args<F>::value)>::type>
+           typename std::enable_if<!needs_prefix_args<F, Args...>::value, int>::type = 0>
   slot(F&& f) : f(std::forward<F>(f)) { }
 
-  template<typename G,
-           typename = typename std::enable_if<(sizeof...(Args) != 0 &&
-                                               is_callable_without_args<G>::value)>::type>
-  slot(G g) : f([g](Args...) -> R { return g(); }) { }
+  template<typename F,
+           typename std::enable_if<needs_prefix_args<F, Args...>::value, int>::type = 0>
+  slot(F&& f) : f(adapt_prefix_args<F, Args...>(std::forward<F>(f))) { }
 
   slot(const slot& s) { (void)s; }
   virtual ~slot() { }
@@ -61,14 +228,12 @@ template<typename...Args>
 class slot<void(Args...)> : public slot_base {
 public:
   template<typename F,
-           typename = typename std::enable_if<(sizeof...(Args) == 0 ||
-                                               !is_callable_without_args<F>::value)>::type>
+           typename std::enable_if<!needs_prefix_args<F, Args...>::value, int>::type = 0>
   slot(F&& f) : f(std::forward<F>(f)) { }
 
-  template<typename G,
-           typename = typename std::enable_if<(sizeof...(Args) != 0 &&
-                                               is_callable_without_args<G>::value)>::type>
-  slot(G g) : f([g](Args...){ g(); }) { }
+  template<typename F,
+           typename std::enable_if<needs_prefix_args<F, Args...>::value, int>::type = 0>
+  slot(F&& f) : f(adapt_prefix_args<F, Args...>(std::forward<F>(f))) { }
 
   slot(const slot& s) { (void)s; }
   virtual ~slot() { }
@@ -0,0 +1,324 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_TIMER_SIGNAL_H_INCLUDED
+#define OBS_TIMER_SIGNAL_H_INCLUDED
+#pragma once
+
+#include "obs/connection.h"
+#include "obs/signal.h"
+#include "obs/slot.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace obs {
+
+// Hierarchical timing wheel: timers are connected to the wheel like
+// slots to a signal, and they are called from advance(), which must
+// be called periodically by the owner of the wheel (e.g. in each
+// iteration of an event loop). Connecting and disconnecting a timer
+// is O(1), so it can handle hundreds of thousands of pending timers.
+//
+// Time is measured in ticks of the given resolution. The wheel has 4
+// levels of 256 slots: timers that expire in the next 256 ticks are
+// in the first level, and timers in the upper levels are moved to
+// the lower ones when their time is near (a timer is moved at most 3
+// times). Timers that expire later than 2^32 ticks are kept in the
+// last level until their time is in range.
+//
+//   obs::timer_wheel wheel(std::chrono::milliseconds(1));
+//   obs::scoped_connection c =
+//     wheel.connect_every(std::chrono::seconds(1), []{ heartbeat(); });
+//   while (running) {
+//     ...
+//     wheel.advance(std::chrono::steady_clock::now());
+//   }
+//
+// Disconnecting the connection cancels the timer. The wheel is not
+// thread-safe: timers must be connected/disconnected in the same
+// thread that calls advance().
+class timer_wheel : public signal_base {
+public:
+  using clock = std::chrono::steady_clock;
+  using duration = clock::duration;
+  using time_point = clock::time_point;
+
+  explicit timer_wheel(duration resolution = std::chrono::milliseconds(1),
+                       time_point start = clock::now())
+    : m_resolution(resolution),
+      m_start(start) {
+    assert(resolution.count() > 0);
+    for (auto& level : m_wheel)
+      for (auto& head : level)
+        head.prev = head.next = &head;
+  }
+
+  ~timer_wheel() {
+    for (auto& level : m_wheel)
+      for (auto& head : level)
+        while (head.next != &head) {
+          timer* t = static_cast<timer*>(head.next);
+          unlink(t);
+          t->reset_handle();
+          t->release();
+        }
+  }
+
+  timer_wheel(const timer_wheel&) = delete;
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  duration resolution() const { return m_resolution; }
+
+  // Time of the last processed tick.
+  time_point now() const { return m_start + m_resolution * m_now; }
+
+  // Number of pending timers.
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Calls "f" once after the given delay (rounded up to the next
+  // tick, at least one tick after now()).
+  template<typename Function>
+  connection connect_after(duration delay, Function&& f) {
+    return add_timer(new timer(std::forward<Function>(f)),
+                     to_ticks(delay), 0);
+  }
+
+  // Calls "f" each "period" (the first call is after one period).
+  template<typename Function>
+  connection connect_every(duration period, Function&& f) {
+    const std::uint64_t ticks = to_ticks(period);
+    return add_timer(new timer(std::forward<Function>(f)), ticks, ticks);
+  }
+
+  // Processes all ticks until the given time calling the expired
+  // timers. Returns the number of called timers.
+  std::size_t advance(time_point t) {
+    if (t <= m_start)
+      return 0;
+    const std::uint64_t target = std::uint64_t((t - m_start) / m_resolution);
+    return (target > m_now ? advance_ticks(target - m_now): 0);
+  }
+
+  // Processes the next "n" ticks.
+  std::size_t advance_ticks(std::uint64_t n) {
+    std::size_t calls = 0;
+    const std::uint64_t target = m_now + n;
+    while (m_now < target) {
+      // Nothing to do in the rest of the ticks
+      if (m_size == 0) {
+        m_now = target;
+        break;
+      }
+
+      ++m_now;
+      cascade();
+      calls += expire(m_wheel[0][m_now & kMask]);
+    }
+    return calls;
+  }
+
+  // signal_base impl
+  void disconnect_slot(slot_base* slot) override {
+    unlink(static_cast<timer*>(slot));
+  }
+
+  // It's O(n), all pending timers are checked.
+  void disconnect_pending_slots() override {
+    for (auto& level : m_wheel)
+      for (auto& head : level)
+        for (node* n=head.next; n!=&head; ) {
+          timer* t = static_cast<timer*>(n);
+          n = n->next;
+          if (t->pending_disconnect()) {
+            t->set_pending_disconnect(false);
+            unlink(t);
+          }
+        }
+  }
+
+private:
+  static constexpr int kLevels = 4;
+  static constexpr int kBits = 8;
+  static constexpr std::size_t kSlots = 1 << kBits;
+  static constexpr std::uint64_t kMask = kSlots-1;
+
+  // Node of the circular lists of timers (each slot of the wheel has
+  // a head node).
+  struct node {
+    node* prev = nullptr;
+    node* next = nullptr;
+  };
+
+  struct timer : slot<void()>, node {
+    template<typename Function>
+    explicit timer(Function&& f) : slot<void()>(std::forward<Function>(f)) { }
+
+    std::uint64_t expiry = 0;   // Tick when the timer is called
+    std::uint64_t period = 0;   // 0 for one-shot timers
+  };
+
+  std::uint64_t to_ticks(duration d) const {
+    if (d.count() <= 0)
+      return 1;
+    return std::max<std::uint64_t>(
+      1, std::uint64_t((d + m_resolution - duration(1)) / m_resolution));
+  }
+
+  connection add_timer(timer* t, std::uint64_t delay, std::uint64_t period) {
+    t->expiry = m_now + delay;
+    t->period = period;
+    insert(t);
+    return connection(this, t);
+  }
+
+  void insert(timer* t) {
+    const std::uint64_t delta = t->expiry - m_now;
+    int level = 0;
+    std::uint64_t expiry = t->expiry;
+    while (level < kLevels-1 && delta >= (std::uint64_t(1) << (kBits*(level+1))))
+      ++level;
+
+    // Timers beyond the range of the wheel are placed in the last
+    // slot that will be visited, they are inserted again when that
+    // slot is cascaded.
+    const std::uint64_t range = std::uint64_t(1) << (kBits*kLevels);
+    if (delta >= range)
+      expiry = m_now + range - 1;
+
+    node& head = m_wheel[level][(expiry >> (kBits*level)) & kMask];
+    t->prev = head.prev;
+    t->next = &head;
+    head.prev->next = t;
+    head.prev = t;
+    ++m_size;
+  }
+
+  void unlink(timer* t) {
+    if (!t->next)
+      return;
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->prev = t->next = nullptr;
+    --m_size;
+  }
+
+  // Moves the timers of the upper levels that expire in the next
+  // ticks to the lower levels.
+  void cascade() {
+    for (int level=1; level<kLevels; ++level) {
+      if ((m_now & ((std::uint64_t(1) << (kBits*level)) - 1)) != 0)
+        break;
+
+      node& head = m_wheel[level][(m_now >> (kBits*level)) & kMask];
+      node list;
+      take(head, list);
+      while (list.next != &list) {
+        timer* t = static_cast<timer*>(list.next);
+        unlink(t);
+        insert(t);
+      }
+    }
+  }
+
+  // Calls all timers in the given slot of the first level.
+  std::size_t expire(node& head) {
+    std::size_t calls = 0;
+
+    // The list is moved to a local head, so timers can be
+    // disconnected (or connected) while we call them.
+    node list;
+    take(head, list);
+    while (list.next != &list) {
+      timer* t = static_cast<timer*>(list.next);
+      unlink(t);
+
+      // Reference to call the timer even if it's disconnected
+      // from its own function.
+      t->add_ref();
+      if (t->period) {
+        t->expiry = m_now + t->period;
+        insert(t);
+      }
+      if (!t->blocked()) {
+        (*t)();
+        ++calls;
+      }
+
+      // One-shot timers are disconnected after they are called (if
+      // they were not disconnected in the call).
+      if (!t->period && t->handle()) {
+        t->reset_handle();
+        t->release();
+      }
+      t->release();
+    }
+    return calls;
+  }
+
+  // Moves all nodes from "head" to "list" (the m_size is unchanged).
+  static void take(node& head, node& list) {
+    if (head.next == &head) {
+      list.prev = list.next = &list;
+      return;
+    }
+    list.next = head.next;
+    list.prev = head.prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    head.prev = head.next = &head;
+  }
+
+  duration m_resolution;
+  time_point m_start;
+  std::uint64_t m_now = 0;      // Last processed tick
+  std::size_t m_size = 0;
+  node m_wheel[kLevels][kSlots];
+};
+
+// A signal emitted by a timer of a timer_wheel, e.g. for timeouts or
+// heartbeats. The timer is stopped when the signal is destroyed.
+class timer_signal : public signal<void()> {
+public:
+  using duration = timer_wheel::duration;
+
+  explicit timer_signal(timer_wheel& wheel) : m_wheel(wheel) { }
+  ~timer_signal() { stop(); }
+
+  timer_signal(const timer_signal&) = delete;
+  timer_signal& operator=(const timer_signal&) = delete;
+
+  // Emits the signal once after the given delay (it restarts the
+  // timer if it was already active).
+  void start_after(duration delay) {
+    stop();
+    m_timer = m_wheel.connect_after(delay, [this]{ (*this)(); });
+  }
+
+  // Emits the signal each "period".
+  void start_every(duration period) {
+    stop();
+    m_timer = m_wheel.connect_every(period, [this]{ (*this)(); });
+  }
+
+  void stop() { m_timer.disconnect(); }
+
+  // True if the timer is pending.
+  bool active() const { return m_timer.connected(); }
+
+private:
+  timer_wheel& m_wheel;
+  connection m_timer;
+};
+
+} // namespace obs
+
+#endif
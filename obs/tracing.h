@@ -0,0 +1,272 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#ifndef OBS_TRACING_H_INCLUDED
+#define OBS_TRACING_H_INCLUDED
+#pragma once
+
+// Tracing of signal emissions is available only when
+// OBSERVABLE_TRACING is defined (see the OBSERVABLE_TRACING option in
+// CMakeLists.txt). Even in that case it must be enabled at runtime
+// with obs::tracing::enable(true), in other case each emission costs
+// just one extra branch.
+#ifdef OBSERVABLE_TRACING
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace obs {
+namespace tracing {
+
+enum class event : std::uint8_t {
+  emit_begin,
+  emit_end,
+  slot_begin,
+  slot_end,
+};
+
+// Fixed-size record saved in the ring buffer of each thread.
+struct record {
+  std::uint64_t time;           // Nanoseconds since the tracing clock epoch
+  const void* id;               // Signal or slot
+  event type;
+};
+
+// Ring buffer of records written by only one thread (the owner) and
+// read by export_chrome_trace() from any thread. When the buffer is
+// full, older records are overwritten.
+//
+// Each entry is protected with a sequence number (index of the record
+// + 1, or 0 while it's being written), so the reader can discard the
+// records that are overwritten while it's copying them.
+class ring_buffer {
+public:
+  ring_buffer(std::size_t capacity, int thread_index)
+    : m_entries(new entry[capacity]),
+      m_capacity(capacity),
+      m_thread_index(thread_index) {
+    assert(capacity > 0);
+  }
+
+  int thread_index() const { return m_thread_index; }
+
+  void add(event type, const void* id) {
+    const std::uint64_t h = m_head.load(std::memory_order_relaxed);
+    entry& e = m_entries[h % m_capacity];
+    // Release stores, so a reader that sees any new field sees the
+    // "seq = 0" too.
+    e.seq.store(0, std::memory_order_relaxed);
+    e.time.store(now(), std::memory_order_release);
+    e.id.store(id, std::memory_order_release);
+    e.type.store(type, std::memory_order_release);
+    e.seq.store(h+1, std::memory_order_release);
+    m_head.store(h+1, std::memory_order_release);
+  }
+
+  // Copies the valid records to "out" (records that were not
+  // overwritten by the owner thread while we were reading them,
+  // including the entry that the owner is writing now).
+  void read(std::vector<record>& out) const {
+    const std::uint64_t cap = m_capacity;
+    const std::uint64_t head = m_head.load(std::memory_order_acquire);
+    std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    if (head > cap && tail < head - cap)
+      tail = head - cap;
+
+    for (std::uint64_t i=tail; i<head; ++i) {
+      const entry& e = m_entries[i % cap];
+      if (e.seq.load(std::memory_order_acquire) != i+1)
+        continue;
+
+      record r;
+      r.time = e.time.load(std::memory_order_acquire);
+      r.id = e.id.load(std::memory_order_acquire);
+      r.type = e.type.load(std::memory_order_acquire);
+      if (e.seq.load(std::memory_order_relaxed) == i+1)
+        out.push_back(r);
+    }
+  }
+
+  void clear() {
+    m_tail.store(m_head.load(std::memory_order_acquire),
+                 std::memory_order_relaxed);
+  }
+
+  static std::uint64_t now() {
+    return std::uint64_t(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+private:
+  struct entry {
+    std::atomic<std::uint64_t> seq = { 0 };
+    std::atomic<std::uint64_t> time = { 0 };
+    std::atomic<const void*> id = { nullptr };
+    std::atomic<event> type = { event::emit_begin };
+  };
+
+  std::unique_ptr<entry[]> m_entries;
+  std::size_t m_capacity;
+  std::atomic<std::uint64_t> m_head = { 0 };
+  std::atomic<std::uint64_t> m_tail = { 0 };
+  int m_thread_index;
+};
+
+// Flag to enable/disable the tracing at runtime. It's a static
+// member of a class template so it's constant-initialized and can be
+// defined in this header (checking it is just one load + branch).
+template<typename T = void>
+struct state {
+  static std::atomic<bool> enabled;
+};
+
+template<typename T>
+std::atomic<bool> state<T>::enabled(false);
+
+// Global state of the tracing system.
+class tracer {
+public:
+  static tracer& instance() {
+    // Never deleted, buffers of finished threads are kept to be
+    // exported.
+    static tracer* t = new tracer;
+    return *t;
+  }
+
+  // Capacity (number of records) of the ring buffers created for new
+  // threads.
+  std::atomic<std::size_t> capacity = { 1 << 16 };
+
+  ring_buffer& thread_buffer() {
+    static thread_local ring_buffer* buffer = nullptr;
+    if (!buffer) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_buffers.emplace_back(new ring_buffer(capacity, int(m_buffers.size())));
+      buffer = m_buffers.back().get();
+    }
+    return *buffer;
+  }
+
+  void set_name(const void* id, const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (name.empty())
+      m_names.erase(id);
+    else
+      m_names[id] = name;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& b : m_buffers)
+      b->clear();
+  }
+
+  void export_chrome_trace(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<record> records;
+    bool first = true;
+
+    os << "{\"traceEvents\":[";
+    for (auto& b : m_buffers) {
+      records.clear();
+      b->read(records);
+      for (const record& r : records) {
+        const bool slot = (r.type == event::slot_begin ||
+                           r.type == event::slot_end);
+        const bool begin = (r.type == event::emit_begin ||
+                            r.type == event::slot_begin);
+        os << (first ? "\n": ",\n")
+           << "{\"name\":\"";
+        if (slot)
+          os << "slot";
+        else
+          write_name(os, r.id);
+        os << "\",\"cat\":\"" << (slot ? "slot": "signal")
+           << "\",\"ph\":\"" << (begin ? "B": "E")
+           << "\",\"ts\":" << (r.time / 1000) << "." << pad3(r.time % 1000)
+           << ",\"pid\":1,\"tid\":" << b->thread_index() << "}";
+        first = false;
+      }
+    }
+    os << "\n]}\n";
+  }
+
+private:
+  void write_name(std::ostream& os, const void* id) const {
+    auto it = m_names.find(id);
+    if (it == m_names.end()) {
+      os << "signal " << id;
+      return;
+    }
+    for (char c : it->second) {
+      if (c == '"' || c == '\\')
+        os << '\\' << c;
+      else if (c >= 0 && c < 0x20)
+        os << ' ';
+      else
+        os << c;
+    }
+  }
+
+  static std::string pad3(std::uint64_t v) {
+    std::string s = std::to_string(v);
+    return std::string(3 - s.size(), '0') + s;
+  }
+
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<ring_buffer>> m_buffers;
+  std::map<const void*, std::string> m_names;
+};
+
+inline void enable(bool on) {
+  state<>::enabled.store(on, std::memory_order_relaxed);
+}
+
+inline bool enabled() {
+  return state<>::enabled.load(std::memory_order_relaxed);
+}
+
+// Capacity of the ring buffers of new threads (at least 1 record).
+inline void set_buffer_capacity(std::size_t records) {
+  tracer::instance().capacity = std::max<std::size_t>(records, 1);
+}
+
+inline void add(event type, const void* id) {
+  tracer::instance().thread_buffer().add(type, id);
+}
+
+inline void set_name(const void* id, const std::string& name) {
+  tracer::instance().set_name(id, name);
+}
+
+// Discards all the recorded events.
+inline void clear() {
+  tracer::instance().clear();
+}
+
+// Writes the recorded events in the Chrome trace event format
+// (which can be loaded in chrome://tracing or https://ui.perfetto.dev).
+inline void export_chrome_trace(std::ostream& os) {
+  tracer::instance().export_chrome_trace(os);
+}
+
+} // namespace tracing
+} // namespace obs
+
+#endif // OBSERVABLE_TRACING
+
+#endif
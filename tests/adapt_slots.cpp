@@ -7,7 +7,16 @@
 #include "obs/signal.h"
 #include "test.h"
 
-int main() {
+#include <memory>
+#include <string>
+
+struct Logger {
+  std::string log;
+  void operator()(int i) { log += std::to_string(i); }
+  void operator()(int i, const std::string& s) { log += std::to_string(i) + s; }
+};
+
+void test_zero_args() {
   static_assert(true == obs::is_callable_without_args<void()>::value, "");
   static_assert(true == obs::is_callable_without_args<int()>::value, "");
   static_assert(false == obs::is_callable_without_args<void(int)>::value, "");
@@ -25,3 +34,48 @@ int main() {
   d(1);
   EXPECT_EQ(4, i);
 }
+
+// Slots can receive just the first arguments of the signal.
+void test_prefix_args() {
+  static_assert(obs::needs_prefix_args<void(*)(int), int, double>::value, "");
+  static_assert(!obs::needs_prefix_args<void(*)(int, double), int, double>::value, "");
+  static_assert(!obs::needs_prefix_args<void(*)(double, int), int, double>::value, "");
+  static_assert(1 == obs::needs_prefix_args<void(*)(int), int, double>::arity, "");
+  static_assert(0 == obs::needs_prefix_args<void(*)(), int, double>::arity, "");
+  static_assert(-1 == obs::needs_prefix_args<void(*)(std::string), int, double>::arity, "");
+
+  std::string log;
+  obs::signal<void(int, const std::string&, double)> sig;
+  sig.connect([&log]{ log += "a"; });
+  sig.connect([&log](int i){ log += "b" + std::to_string(i); });
+  sig.connect([&log](int i, const std::string& s){ log += "c" + std::to_string(i) + s; });
+  sig.connect([&log](int i, const std::string& s, double d){
+                log += "d" + std::to_string(i) + s + std::to_string(int(d));
+              });
+  sig(1, "x", 2.5);
+  EXPECT_EQ("ab1c1xd1x2", log);
+
+  // Functors with several overloads use the one with more arguments
+  Logger logger;
+  obs::signal<void(int, std::string, double)> sig2;
+  sig2.connect(std::ref(logger));
+  sig2(2, "y", 0.0);
+  EXPECT_EQ("2y", logger.log);
+
+  // Rvalue arguments are moved to the slot
+  obs::signal<void(std::unique_ptr<int>, int)> sig3;
+  int value = 0;
+  sig3.connect([&value](std::unique_ptr<int> p){ value = *p; });
+  sig3(std::unique_ptr<int>(new int(5)), 0);
+  EXPECT_EQ(5, value);
+
+  // Signals with results
+  obs::signal<int(int, int)> sig4;
+  sig4.connect([](int a){ return a*2; });
+  EXPECT_EQ(6, sig4(3, 4));
+}
+
+int main() {
+  test_zero_args();
+  test_prefix_args();
+}
@@ -0,0 +1,78 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#pragma once
+
+// Replaces the global operator new/delete to count the allocations
+// made by the current thread. This header must be included in only
+// one translation unit of each program.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace alloc_counter {
+
+struct counts {
+  std::size_t allocs;
+  std::size_t bytes;
+};
+
+inline counts& thread_counts() {
+  static thread_local counts c = { 0, 0 };
+  return c;
+}
+
+// Counts the allocations made in the current thread since its
+// creation (or the last reset()).
+class scope {
+public:
+  scope() { reset(); }
+
+  void reset() { m_start = thread_counts(); }
+
+  std::size_t allocs() const { return thread_counts().allocs - m_start.allocs; }
+  std::size_t bytes() const { return thread_counts().bytes - m_start.bytes; }
+
+private:
+  counts m_start;
+};
+
+inline void* allocate(std::size_t size) {
+  counts& c = thread_counts();
+  ++c.allocs;
+  c.bytes += size;
+  void* p = std::malloc(size ? size: 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+} // namespace alloc_counter
+
+void* operator new(std::size_t size) {
+  return alloc_counter::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return alloc_counter::allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+  std::free(p);
+}
@@ -0,0 +1,89 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+template<typename Signal>
+void test_block() {
+  Signal sig;
+  int a = 0, b = 0;
+  obs::connection conn_a = sig.connect([&a]{ ++a; });
+  obs::connection conn_b = sig.connect([&b]{ ++b; });
+
+  conn_a.block();
+  EXPECT_TRUE(conn_a.blocked());
+  sig();
+  EXPECT_EQ(0, a);
+  EXPECT_EQ(1, b);
+
+  conn_a.unblock();
+  EXPECT_FALSE(conn_a.blocked());
+  sig();
+  EXPECT_EQ(1, a);
+  EXPECT_EQ(2, b);
+
+  // Nested blocks
+  {
+    obs::shared_connection_block block1(conn_b);
+    {
+      obs::shared_connection_block block2(conn_b);
+      sig();
+    }
+    EXPECT_TRUE(conn_b.blocked());
+    sig();
+    EXPECT_EQ(3, a);
+    EXPECT_EQ(2, b);
+
+    block1.unblock();
+    EXPECT_FALSE(block1.blocking());
+    sig();
+    EXPECT_EQ(3, b);
+  }
+  EXPECT_FALSE(conn_b.blocked());
+
+  conn_a.disconnect();
+  conn_b.disconnect();
+}
+
+// Blocking a slot from other slot in the same emission
+template<typename Signal>
+void test_block_on_signal() {
+  Signal sig;
+  int a = 0, b = 0;
+  obs::connection conn_b;
+  obs::connection conn_a = sig.connect([&a, &conn_b]{
+                                         ++a;
+                                         conn_b.block();
+                                       });
+  conn_b = sig.connect([&b]{ ++b; });
+
+  sig();
+  EXPECT_EQ(1, a);
+  EXPECT_EQ(0, b);
+
+  conn_a.disconnect();
+  conn_b.disconnect();
+}
+
+int main() {
+  test_block<obs::safe_signal<void()>>();
+  test_block<obs::fast_signal<void()>>();
+  test_block_on_signal<obs::safe_signal<void()>>();
+  test_block_on_signal<obs::fast_signal<void()>>();
+
+  // Blocked slots in non-void signals don't change the result
+  {
+    obs::signal<int()> sig;
+    obs::scoped_connection c1 = sig.connect([]{ return 1; });
+    obs::connection c2 = sig.connect([]{ return 2; });
+    EXPECT_EQ(2, sig());
+    obs::shared_connection_block block(c2);
+    EXPECT_EQ(1, sig());
+    block.unblock();
+    c2.disconnect();
+  }
+}
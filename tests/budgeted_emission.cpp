@@ -0,0 +1,218 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Clock controlled by the test (each slot advances it one tick).
+struct fake_clock {
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<fake_clock>;
+  static const bool is_steady = true;
+
+  static time_point now() { return time_point(duration(ticks)); }
+  static void advance() { ++ticks; }
+
+  static rep ticks;
+};
+
+fake_clock::rep fake_clock::ticks = 0;
+
+static fake_clock::time_point after(int ticks) {
+  return fake_clock::now() + fake_clock::duration(ticks);
+}
+
+template<typename Signal>
+void test_budget() {
+  Signal sig;
+  std::string log;
+  obs::connection_group conns;
+  for (int i=0; i<5; ++i)
+    conns.add(sig.connect([&log, i](const std::string& s){
+                                  log += s + std::to_string(i);
+                                  fake_clock::advance();
+                                }));
+
+  typename Signal::pending_emission pending;
+  EXPECT_TRUE(pending.empty());
+  EXPECT_EQ(3u, sig.emit_until(pending, after(2), std::string("a")));
+  EXPECT_EQ("a0a1", log);
+  EXPECT_FALSE(pending.empty());
+  EXPECT_EQ(3u, pending.remaining());
+  EXPECT_EQ(2u, pending.called());
+
+  // At least one slot is called even if the deadline was reached
+  EXPECT_EQ(2u, sig.resume(pending, after(0)));
+  EXPECT_EQ("a0a1a2", log);
+
+  EXPECT_EQ(0u, sig.resume(pending, after(10)));
+  EXPECT_EQ("a0a1a2a3a4", log);
+  EXPECT_TRUE(pending.empty());
+  EXPECT_EQ(5u, pending.called());
+  EXPECT_EQ(0u, sig.resume(pending, after(10)));
+
+  // The cursor can be reused for a new emission
+  log.clear();
+  EXPECT_EQ(0u, sig.emit_until(pending, after(10), std::string("b")));
+  EXPECT_EQ("b0b1b2b3b4", log);
+}
+
+// Slots connected after the emission started are not called, and
+// disconnected slots are skipped.
+template<typename Signal>
+void test_connect_disconnect() {
+  Signal sig;
+  std::string log;
+  std::vector<obs::connection> conns;
+  for (int i=0; i<4; ++i)
+    conns.push_back(sig.connect([&log, i](int v){
+                                  log += std::to_string(v*10 + i) + " ";
+                                  fake_clock::advance();
+                                }));
+
+  typename Signal::pending_emission pending;
+  EXPECT_EQ(3u, sig.emit_until(pending, after(1), 1));
+  EXPECT_EQ("10 ", log);
+
+  obs::scoped_connection c =
+    sig.connect([&log](int){ log += "new "; });
+  conns[2].disconnect();
+  conns[0].disconnect();
+
+  EXPECT_EQ(0u, sig.resume(pending, after(10)));
+  EXPECT_EQ("10 11 13 ", log);
+  EXPECT_EQ(3u, pending.called());
+
+  // A slot can disconnect the next slot
+  log.clear();
+  obs::connection next;
+  obs::scoped_connection first =
+    sig.connect(1, [&log, &next](int){
+                     log += "first ";
+                     next.disconnect();
+                   });
+  next = sig.connect(1, [&log](int){ log += "next "; });
+  EXPECT_EQ(0u, sig.emit_until(pending, after(10), 2));
+  EXPECT_EQ("first 21 23 new ", log);
+
+  conns[1].disconnect();
+  conns[3].disconnect();
+}
+
+// A cancelled emission releases its slots.
+void test_reset() {
+  obs::signal<void(int)> sig;
+  int calls = 0;
+  obs::connection c = sig.connect([&calls](int){
+                                    ++calls;
+                                    fake_clock::advance();
+                                  });
+  obs::scoped_connection c2 = sig.connect([&calls](int){ ++calls; });
+
+  obs::signal<void(int)>::pending_emission pending;
+  EXPECT_EQ(1u, sig.emit_until(pending, after(1), 0));
+  c.disconnect();
+  pending.reset();
+  EXPECT_TRUE(pending.empty());
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(0u, sig.resume(pending, after(1)));
+  EXPECT_EQ(1, calls);
+
+  // An emission without slots finishes immediately
+  obs::signal<void(int)> empty;
+  EXPECT_EQ(0u, empty.emit_until(pending, after(1), 0));
+  EXPECT_TRUE(pending.empty());
+}
+
+// Blocked slots and slots of destroyed objects are skipped.
+void test_blocked_and_tracked() {
+  obs::signal<void()> sig;
+  std::string log;
+  auto owner = std::make_shared<int>(0);
+  sig.connect(owner, [&log]{ log += "t"; fake_clock::advance(); });
+  obs::connection a = sig.connect([&log]{ log += "a"; fake_clock::advance(); });
+  obs::scoped_connection b = sig.connect([&log]{ log += "b"; fake_clock::advance(); });
+
+  obs::signal<void()>::pending_emission pending;
+  EXPECT_EQ(2u, sig.emit_until(pending, after(1)));
+  EXPECT_EQ("t", log);
+
+  owner.reset();
+  a.block();
+  EXPECT_EQ(0u, sig.resume(pending, after(10)));
+  EXPECT_EQ("tb", log);
+  EXPECT_EQ(2u, pending.called());
+
+  // The expired slot was disconnected
+  log.clear();
+  a.unblock();
+  EXPECT_EQ(0u, sig.emit_until(pending, after(10)));
+  EXPECT_EQ("ab", log);
+  a.disconnect();
+}
+
+// A slot of a destroyed object that is deferred in a pending
+// emission is disposed by another emission, the pending emission
+// keeps it alive until it's skipped.
+template<typename Signal>
+void test_dispose_deferred_slot() {
+  Signal sig;
+  std::string log;
+  auto owner = std::make_shared<int>(0);
+  obs::scoped_connection a = sig.connect([&log](int){ log += "a"; });
+  obs::connection t = sig.connect(owner, [&log](int){ log += "t"; });
+
+  typename Signal::pending_emission pending;
+  EXPECT_EQ(1u, sig.emit_until(pending, after(-1), 1));
+  EXPECT_EQ("a", log);
+
+  owner.reset();
+  sig(2);
+  EXPECT_EQ("aa", log);
+
+  // The connection of the disposed slot doesn't release it again
+  EXPECT_FALSE(t.connected());
+  t.disconnect();
+  EXPECT_EQ(0u, sig.resume(pending, after(10)));
+  EXPECT_EQ("aa", log);
+  EXPECT_TRUE(pending.empty());
+}
+
+// A time budget with the real clock.
+void test_steady_clock() {
+  obs::signal<void()> sig;
+  int calls = 0;
+  obs::connection_group conns;
+  for (int i=0; i<100; ++i)
+    conns.add(sig.connect([&calls]{ ++calls; }));
+
+  obs::signal<void()>::pending_emission pending;
+  sig.emit_until(pending, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  EXPECT_TRUE(pending.empty());
+  EXPECT_EQ(100, calls);
+}
+
+int main() {
+  test_budget<obs::safe_signal<void(const std::string&)>>();
+  test_budget<obs::fast_signal<void(const std::string&)>>();
+  test_budget<obs::cow_signal<void(const std::string&)>>();
+  test_connect_disconnect<obs::safe_signal<void(int)>>();
+  test_connect_disconnect<obs::fast_signal<void(int)>>();
+  test_connect_disconnect<obs::cow_signal<void(int)>>();
+  test_reset();
+  test_blocked_and_tracked();
+  test_dispose_deferred_slot<obs::safe_signal<void(int)>>();
+  test_dispose_deferred_slot<obs::fast_signal<void(int)>>();
+  test_dispose_deferred_slot<obs::cow_signal<void(int)>>();
+  test_steady_clock();
+}
@@ -0,0 +1,61 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+template<typename Signal>
+void test_group() {
+  Signal a, b, c;
+  int count = 0;
+  {
+    obs::connection_group group;
+    for (int i=0; i<10; ++i) {
+      group += a.connect([&count]{ ++count; });
+      group += b.connect([&count]{ ++count; });
+    }
+    group += c.connect([&count]{ ++count; });
+    EXPECT_EQ(21u, group.size());
+
+    a(); b(); c();
+    EXPECT_EQ(21, count);
+  }
+  EXPECT_FALSE(a);
+  EXPECT_FALSE(b);
+  EXPECT_FALSE(c);
+
+  a(); b(); c();
+  EXPECT_EQ(21, count);
+}
+
+// Disconnect a group from one of its own slots
+template<typename Signal>
+void test_disconnect_on_signal() {
+  Signal sig;
+  int count = 0;
+  obs::connection_group group;
+  obs::connection other = sig.connect([&count]{ ++count; });
+  group += sig.connect([&group, &count]{
+                         ++count;
+                         group.disconnect();
+                       });
+  group += sig.connect([&count]{ ++count; });
+
+  sig();
+  EXPECT_TRUE(group.empty());
+  EXPECT_EQ(2, count);
+
+  sig();
+  EXPECT_EQ(3, count);
+  other.disconnect();
+  EXPECT_FALSE(sig);
+}
+
+int main() {
+  test_group<obs::safe_signal<void()>>();
+  test_group<obs::fast_signal<void()>>();
+  test_disconnect_on_signal<obs::safe_signal<void()>>();
+}
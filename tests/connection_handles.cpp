@@ -0,0 +1,104 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <memory>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<obs::connection>::value,
+              "connection handles must be trivially copyable");
+static_assert(sizeof(obs::connection) == 8,
+              "connection handles must be compact");
+
+// Disconnecting a connection after the signal was destroyed does
+// nothing.
+void test_after_signal_dtor() {
+  obs::connection c;
+  {
+    obs::signal<void()> sig;
+    c = sig.connect([]{ });
+    EXPECT_TRUE(c);
+  }
+  EXPECT_FALSE(c);
+  EXPECT_FALSE(c.blocked());
+  c.block();
+  c.unblock();
+  c.disconnect();
+  EXPECT_FALSE(c);
+
+  // Same for scoped connections that outlive the signal
+  std::unique_ptr<obs::signal<void()>> sig(new obs::signal<void()>);
+  obs::scoped_connection sc = sig->connect([]{ });
+  sig.reset();
+}
+
+// All copies of a connection see the disconnection.
+void test_copies() {
+  obs::signal<void()> sig;
+  int calls = 0;
+  obs::connection a = sig.connect([&]{ ++calls; });
+  obs::connection b = a;
+  sig();
+  EXPECT_EQ(1, calls);
+
+  b.disconnect();
+  EXPECT_FALSE(a);
+  EXPECT_FALSE(b);
+  a.disconnect();   // Does nothing
+  sig();
+  EXPECT_EQ(1, calls);
+}
+
+// An old handle doesn't affect a new slot which reuses its entry in
+// the slot table.
+void test_reused_entry() {
+  obs::signal<void()> sig;
+  int a_calls = 0, b_calls = 0;
+  obs::connection a = sig.connect([&]{ ++a_calls; });
+  obs::connection old = a;
+  a.disconnect();
+
+  obs::connection b = sig.connect([&]{ ++b_calls; });
+  EXPECT_TRUE(b);
+  EXPECT_FALSE(old);
+  old.block();
+  old.disconnect();
+  EXPECT_TRUE(b);
+  EXPECT_FALSE(b.blocked());
+
+  sig();
+  EXPECT_EQ(0, a_calls);
+  EXPECT_EQ(1, b_calls);
+  b.disconnect();
+}
+
+// Groups skip connections that were already disconnected (or added
+// twice).
+void test_group() {
+  obs::signal<void()> sig;
+  int calls = 0;
+  obs::connection a = sig.connect([&]{ ++calls; });
+  obs::connection b = sig.connect([&]{ ++calls; });
+  {
+    obs::connection_group group;
+    group += a;
+    group += a;
+    group += b;
+    b.disconnect();
+  }
+  EXPECT_FALSE(a);
+  sig();
+  EXPECT_EQ(0, calls);
+}
+
+int main() {
+  test_after_signal_dtor();
+  test_copies();
+  test_reused_entry();
+  test_group();
+}
@@ -0,0 +1,172 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "alloc_counter.h"
+#include "test.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using sig_t = obs::cow_signal<void(std::string&)>;
+
+// Copies share the slots of the original signal without allocating
+// memory.
+void test_copy() {
+  sig_t proto;
+  obs::scoped_connection a = proto.connect([](std::string& s){ s += "a"; });
+  obs::scoped_connection b = proto.connect([](std::string& s){ s += "b"; });
+
+  alloc_counter::scope scope;
+  std::vector<sig_t> clones(100, proto);
+  EXPECT_EQ(1u, scope.allocs());   // Just the vector buffer
+
+  for (auto& clone : clones) {
+    std::string log;
+    clone(log);
+    EXPECT_EQ("ab", log);
+  }
+}
+
+// Connecting/disconnecting slots in a copy doesn't modify the
+// original signal (and vice versa).
+void test_copy_on_write() {
+  sig_t proto;
+  obs::connection a = proto.connect([](std::string& s){ s += "a"; });
+  sig_t clone = proto;
+
+  obs::connection c = clone.connect([](std::string& s){ s += "c"; });
+  std::string log;
+  proto(log);
+  EXPECT_EQ("a", log);
+  log.clear();
+  clone(log);
+  EXPECT_EQ("ac", log);
+
+  // The original slot is still called by the clone
+  a.disconnect();
+  EXPECT_FALSE(a);
+  log.clear();
+  proto(log);
+  EXPECT_EQ("", log);
+  log.clear();
+  clone(log);
+  EXPECT_EQ("ac", log);
+
+  c.disconnect();
+  log.clear();
+  clone(log);
+  EXPECT_EQ("a", log);
+
+  // Assignment shares the slots too
+  clone = proto;
+  log.clear();
+  clone(log);
+  EXPECT_EQ("", log);
+}
+
+// Connections to a destroyed signal are invalidated even if its slots
+// are still used by copies.
+void test_destroy_original() {
+  std::unique_ptr<sig_t> proto(new sig_t);
+  obs::connection a = proto->connect([](std::string& s){ s += "a"; });
+  sig_t clone = *proto;
+  proto.reset();
+  EXPECT_FALSE(a);
+  a.disconnect();
+
+  std::string log;
+  clone(log);
+  EXPECT_EQ("a", log);
+}
+
+// Slots disconnected in the middle of an emission are not called by
+// the emission in progress (copies of the signal still call them).
+void test_disconnect_in_emit() {
+  sig_t sig;
+  obs::connection b;
+  obs::scoped_connection a =
+    sig.connect([&b](std::string& s) {
+                  s += "a";
+                  b.disconnect();
+                });
+  b = sig.connect([](std::string& s){ s += "b"; });
+  sig_t clone = sig;
+
+  std::string log;
+  sig(log);
+  EXPECT_EQ("a", log);
+  log.clear();
+  sig(log);
+  EXPECT_EQ("a", log);
+
+  log.clear();
+  clone(log);
+  EXPECT_EQ("ab", log);
+}
+
+// Tracked slots are removed from each copy.
+void test_tracked() {
+  sig_t proto;
+  auto owner = std::make_shared<int>(0);
+  proto.connect(owner, [](std::string& s){ s += "t"; });
+  sig_t clone = proto;
+
+  std::string log;
+  clone(log);
+  EXPECT_EQ("t", log);
+
+  owner.reset();
+  log.clear();
+  clone(log);
+  proto(log);
+  EXPECT_EQ("", log);
+  EXPECT_FALSE(clone);
+  EXPECT_FALSE(proto);
+}
+
+// Copies in different threads can dispose the same expired slot at
+// the same time.
+void test_tracked_in_threads() {
+  for (int i=0; i<100; ++i) {
+    sig_t proto;
+    auto owner = std::make_shared<int>(0);
+    obs::connection c = proto.connect(owner, [](std::string& s){ s += "t"; });
+    sig_t a = proto;
+    sig_t b = proto;
+    owner.reset();
+
+    std::thread ta([&a]{ std::string log; a(log); });
+    std::thread tb([&b]{ std::string log; b(log); });
+    ta.join();
+    tb.join();
+    EXPECT_FALSE(a);
+    EXPECT_FALSE(b);
+    EXPECT_FALSE(c.connected());
+  }
+
+  // Connection handles are not shared after that
+  sig_t sig;
+  obs::connection x = sig.connect([](std::string&){ });
+  obs::connection y = sig.connect([](std::string&){ });
+  EXPECT_TRUE(x.connected());
+  EXPECT_TRUE(y.connected());
+  x.disconnect();
+  EXPECT_FALSE(x.connected());
+  EXPECT_TRUE(y.connected());
+  y.disconnect();
+}
+
+int main() {
+  test_copy();
+  test_copy_on_write();
+  test_destroy_original();
+  test_disconnect_in_emit();
+  test_tracked();
+  test_tracked_in_threads();
+}
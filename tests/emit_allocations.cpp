@@ -0,0 +1,176 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs.h"
+#include "alloc_counter.h"
+#include "test.h"
+
+#include <memory>
+#include <string>
+
+// Emissions (and notifications) must not allocate memory. A fast_list
+// can allocate its reusable buffer when it's iterated with more
+// elements than before, so we emit once before counting.
+
+const int kEmits = 100;
+
+struct Counter {
+  int n = 0;
+  void inc(int v) { n += v; }
+  int twice(int v) { n += v; return v*2; }
+};
+
+template<typename Signal>
+void test_void_signal() {
+  Signal sig;
+  Counter counter;
+  auto owner = std::make_shared<Counter>();
+
+  obs::scoped_connection a = sig.connect([&counter](int v){ counter.n += v; });
+  obs::scoped_connection b = sig.connect(&Counter::inc, &counter);
+  obs::scoped_connection c = sig.connect(5, [&counter](int v){ counter.n -= v; });
+  obs::connection d = sig.connect([&counter](int){ counter.n += 1000; });
+  sig.connect(owner, [&counter](int v){ counter.n += v; });
+  d.block();
+
+  sig(1);
+
+  alloc_counter::scope scope;
+  for (int i=0; i<kEmits; ++i)
+    sig(1);
+  EXPECT_EQ(0u, scope.allocs());
+  EXPECT_EQ(2*(kEmits+1), counter.n);
+}
+
+template<typename Signal>
+void test_result_signal() {
+  Signal sig;
+  Counter counter;
+  obs::scoped_connection a = sig.connect(&Counter::twice, &counter);
+  obs::scoped_connection b = sig.connect([](int v){ return v+1; });
+
+  EXPECT_EQ(3, sig(2));
+
+  alloc_counter::scope scope;
+  int result = 0;
+  for (int i=0; i<kEmits; ++i)
+    result += sig(2);
+  EXPECT_EQ(0u, scope.allocs());
+  EXPECT_EQ(3*kEmits, result);
+}
+
+// Disconnecting a slot in the middle of the emission (the slot was
+// already called, a fast_list cannot disconnect slots that are
+// going to be called in the same emission).
+template<typename Signal>
+void test_disconnect_in_emit() {
+  Signal sig;
+  obs::connection conn;
+  int n = 0;
+  obs::scoped_connection a = sig.connect([&conn, &n](int){
+                                           ++n;
+                                           conn.disconnect();
+                                         });
+  conn = sig.connect(1, [](int){ });
+  sig(1);
+
+  alloc_counter::scope scope;
+  for (int i=0; i<kEmits; ++i) {
+    conn = sig.connect(1, [](int){ });
+    const std::size_t before = scope.allocs();
+    sig(1);
+    EXPECT_EQ(before, scope.allocs());
+  }
+  EXPECT_EQ(kEmits+1, n);
+}
+
+struct Observer {
+  int n = 0;
+  void on_event(int v) { n += v; }
+};
+
+template<typename Observers>
+void test_observers() {
+  Observers obs;
+  Observer a, b;
+  obs.add_observer(&a);
+  obs.add_observer(&b);
+
+  obs.notify_observers(&Observer::on_event, 1);
+
+  alloc_counter::scope scope;
+  for (int i=0; i<kEmits; ++i)
+    obs.notify_observers(&Observer::on_event, 1);
+  EXPECT_EQ(0u, scope.allocs());
+  EXPECT_EQ(kEmits+1, a.n);
+  EXPECT_EQ(kEmits+1, b.n);
+}
+
+void test_operators() {
+  obs::signal<void(int)> sig;
+  int sum = 0;
+  obs::scoped_connection c =
+    (obs::from(sig)
+     | obs::filter([](int x){ return x > 0; })
+     | obs::map([](int x){ return x*2; }))
+    .connect([&sum](int y){ sum += y; });
+
+  sig(1);
+
+  alloc_counter::scope scope;
+  for (int i=0; i<kEmits; ++i) {
+    sig(1);
+    sig(-1);
+  }
+  EXPECT_EQ(0u, scope.allocs());
+  EXPECT_EQ(2*(kEmits+1), sum);
+}
+
+// Slots that receive only the first arguments don't need more
+// allocations than slots with the exact signature.
+void test_prefix_args() {
+  obs::signal<void(int, const std::string&)> sig;
+  int n = 0;
+  const std::string text = "a string that doesn't fit in the small buffer";
+
+  alloc_counter::scope scope;
+  obs::scoped_connection a = sig.connect([&n](int v, const std::string&){ n += v; });
+  const std::size_t exact = scope.allocs();
+  scope.reset();
+  obs::scoped_connection b = sig.connect([&n](int v){ n += v; });
+  EXPECT_EQ(exact, scope.allocs());
+
+  sig(1, text);
+  scope.reset();
+  for (int i=0; i<kEmits; ++i)
+    sig(1, text);
+  EXPECT_EQ(0u, scope.allocs());
+  EXPECT_EQ(2*(kEmits+1), n);
+}
+
+// Checks that the harness works.
+void test_counter() {
+  alloc_counter::scope scope;
+  std::unique_ptr<int> p(new int(1));
+  EXPECT_EQ(1u, scope.allocs());
+  EXPECT_EQ(sizeof(int), scope.bytes());
+}
+
+int main() {
+  test_counter();
+  test_void_signal<obs::safe_signal<void(int)>>();
+  test_void_signal<obs::fast_signal<void(int)>>();
+  test_void_signal<obs::cow_signal<void(int)>>();
+  test_result_signal<obs::safe_signal<int(int)>>();
+  test_result_signal<obs::fast_signal<int(int)>>();
+  test_result_signal<obs::cow_signal<int(int)>>();
+  test_disconnect_in_emit<obs::safe_signal<void(int)>>();
+  test_disconnect_in_emit<obs::fast_signal<void(int)>>();
+  test_observers<obs::safe_observers<Observer>>();
+  test_observers<obs::fast_observers<Observer>>();
+  test_operators();
+  test_prefix_args();
+}
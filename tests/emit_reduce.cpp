@@ -0,0 +1,164 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Minimal thread pool used as executor.
+class thread_pool {
+public:
+  explicit thread_pool(int n) {
+    for (int i=0; i<n; ++i)
+      m_threads.emplace_back([this]{ run(); });
+  }
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& t : m_threads)
+      t.join();
+  }
+
+  void operator()(std::function<void()> f) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(f));
+      ++m_posted;
+    }
+    m_cv.notify_one();
+  }
+
+  int posted() const { return m_posted; }
+
+private:
+  void run() {
+    for (;;) {
+      std::function<void()> f;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]{ return m_stop || !m_tasks.empty(); });
+        if (m_tasks.empty())
+          return;
+        f = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      f();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop = false;
+  std::atomic<int> m_posted = { 0 };
+};
+
+template<typename Signal>
+void test_sum(thread_pool& pool) {
+  Signal sig;
+  std::vector<obs::scoped_connection> conns(100);
+  for (int i=0; i<100; ++i)
+    conns[i] = sig.connect([i](int x){ return i*x; });
+
+  auto plus = [](int a, int b){ return a+b; };
+  const int serial = sig(1);  // Last result wins
+  EXPECT_EQ(99, serial);
+
+  const int posted = pool.posted();
+  EXPECT_EQ(2*4950, sig.emit_reduce(pool, plus, 2));
+  EXPECT_TRUE(pool.posted() > posted);
+
+  // Serial reduce (same result)
+  sig.set_min_parallel_slots(1000);
+  EXPECT_EQ(1000u, sig.min_parallel_slots());
+  const int posted2 = pool.posted();
+  EXPECT_EQ(2*4950, sig.emit_reduce(pool, plus, 2));
+  EXPECT_EQ(posted2, pool.posted());
+}
+
+// The order of the slots is kept for non-commutative combiners.
+void test_order(thread_pool& pool) {
+  obs::signal<std::string()> sig;
+  std::vector<obs::scoped_connection> conns(50);
+  std::string expected;
+  for (int i=0; i<50; ++i) {
+    conns[i] = sig.connect([i]{ return std::to_string(i) + ","; });
+    expected += std::to_string(i) + ",";
+  }
+  auto concat = [](std::string a, const std::string& b){ return a + b; };
+  for (int i=0; i<10; ++i)
+    EXPECT_EQ(expected, sig.emit_reduce(pool, concat));
+}
+
+// Slots are called in several threads (the calling thread too).
+void test_threads(thread_pool& pool) {
+  obs::signal<int()> sig;
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  std::vector<obs::scoped_connection> conns(32);
+  for (auto& c : conns)
+    c = sig.connect([&]{
+                      std::lock_guard<std::mutex> lock(mutex);
+                      ids.insert(std::this_thread::get_id());
+                      return 1;
+                    });
+  auto plus = [](int a, int b){ return a+b; };
+  EXPECT_EQ(32, sig.emit_reduce(pool, plus));
+  EXPECT_TRUE(ids.size() >= 2);
+  EXPECT_TRUE(ids.count(std::this_thread::get_id()) == 1);
+}
+
+// Blocked and expired slots are skipped, and slots can be
+// disconnected while they are called.
+void test_skipped(thread_pool& pool) {
+  obs::signal<int()> sig;
+  sig.set_min_parallel_slots(2);
+
+  auto plus = [](int a, int b){ return a+b; };
+  EXPECT_EQ(0, sig.emit_reduce(pool, plus));
+
+  auto owner = std::make_shared<int>(0);
+  sig.connect(owner, []{ return 100; });
+  obs::connection blocked = sig.connect([]{ return 1000; });
+  blocked.block();
+  obs::connection self;
+  self = sig.connect([&self]{
+                       self.disconnect();
+                       return 10;
+                     });
+  obs::scoped_connection a = sig.connect([]{ return 1; });
+  obs::scoped_connection b = sig.connect([]{ return 2; });
+
+  EXPECT_EQ(113, sig.emit_reduce(pool, plus));
+  owner.reset();
+  EXPECT_EQ(3, sig.emit_reduce(pool, plus));
+  blocked.disconnect();
+}
+
+int main() {
+  thread_pool pool(3);
+  test_sum<obs::safe_signal<int(int)>>(pool);
+  test_sum<obs::fast_signal<int(int)>>(pool);
+  test_order(pool);
+  test_threads(pool);
+  test_skipped(pool);
+}
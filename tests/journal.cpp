@@ -0,0 +1,196 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/journal.h"
+#include "test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+struct point {
+  double x, y;
+};
+
+static std::string temp_path(const char* name) {
+  return "/tmp/obs_journal_" + std::to_string(::getpid()) + "_" + name;
+}
+
+void test_record_and_replay() {
+  const std::string path = temp_path("replay");
+  obs::signal<void(int, const point&)> moved;
+  obs::signal<void()> clicked;
+  {
+    obs::journal_writer journal(path);
+    EXPECT_TRUE(journal.is_open());
+    obs::scoped_connection a = journal.record(moved, 1);
+    obs::scoped_connection b = journal.record(clicked, 2);
+
+    moved(1, point{ 1.5, 2.5 });
+    clicked();
+    moved(2, point{ 3.0, 4.0 });
+    EXPECT_EQ(3u, journal.records());
+    EXPECT_EQ(0u, journal.dropped());
+  }
+
+  // Emissions after the recorder is disconnected are not recorded
+  moved(3, point{ 0, 0 });
+
+  obs::journal_reader reader(path);
+  EXPECT_TRUE(reader.is_open());
+  std::vector<std::uint32_t> ids;
+  for (const obs::journal_record& r : reader)
+    ids.push_back(r.signal_id);
+  EXPECT_EQ(3u, ids.size());
+  EXPECT_EQ(1u, ids[0]);
+  EXPECT_EQ(2u, ids[1]);
+  EXPECT_EQ(1u, ids[2]);
+
+  // Replay in a test harness
+  obs::signal<void(int, const point&)> moved2;
+  obs::signal<void()> clicked2;
+  std::string log;
+  obs::scoped_connection c =
+    moved2.connect([&log](int i, const point& p){
+                     log += std::to_string(i) + ":" +
+                       std::to_string(int(p.x*10)) + "," +
+                       std::to_string(int(p.y*10)) + " ";
+                   });
+  obs::scoped_connection d =
+    clicked2.connect([&log]{ log += "click "; });
+
+  obs::journal_replayer replayer;
+  replayer.add(1, moved2);
+  replayer.add(2, clicked2);
+  EXPECT_EQ(3u, replayer.replay(reader));
+  EXPECT_EQ("1:15,25 click 2:30,40 ", log);
+
+  // Unknown signals are skipped
+  log.clear();
+  replayer.remove(2);
+  EXPECT_EQ(2u, replayer.replay(reader));
+  EXPECT_EQ("1:15,25 2:30,40 ", log);
+  EXPECT_EQ(1u, replayer.skipped());
+
+  // A signal with other arguments doesn't match the recorded payload
+  obs::signal<void(double)> other;
+  obs::journal_replayer replayer2;
+  replayer2.add(1, other);
+  EXPECT_EQ(0u, replayer2.replay(reader));
+  EXPECT_EQ(3u, replayer2.skipped());
+
+  std::remove(path.c_str());
+}
+
+// The intervals between emissions are kept with
+// replay_speed::recorded.
+void test_recorded_speed() {
+  const std::string path = temp_path("speed");
+  obs::signal<void(int)> sig;
+  {
+    obs::journal_writer journal(path);
+    obs::scoped_connection c = journal.record(sig, 7);
+    sig(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    sig(2);
+  }
+
+  obs::journal_reader reader(path);
+  obs::signal<void(int)> sig2;
+  int sum = 0;
+  obs::scoped_connection c = sig2.connect([&sum](int v){ sum += v; });
+  obs::journal_replayer replayer;
+  replayer.add(7, sig2);
+
+  auto t0 = std::chrono::steady_clock::now();
+  EXPECT_EQ(2u, replayer.replay(reader, obs::replay_speed::recorded));
+  EXPECT_TRUE(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(30));
+  EXPECT_EQ(3, sum);
+
+  std::remove(path.c_str());
+}
+
+// Emissions from several threads, and a full journal.
+void test_threads_and_capacity() {
+  const std::string path = temp_path("threads");
+  const int kThreads = 4;
+  const int kEvents = 1000;
+  obs::signal<void(int)> sig;
+  {
+    obs::journal_writer journal(path, 1 << 20);
+    obs::scoped_connection c = journal.record(sig, 1);
+    std::vector<std::thread> threads;
+    for (int i=0; i<kThreads; ++i)
+      threads.emplace_back([&sig]{
+                             for (int j=0; j<kEvents; ++j)
+                               sig(1);
+                           });
+    for (auto& t : threads)
+      t.join();
+    EXPECT_EQ(std::uint64_t(kThreads*kEvents), journal.records());
+  }
+
+  obs::journal_reader reader(path);
+  std::vector<int> per_thread;
+  int n = 0;
+  for (const obs::journal_record& r : reader) {
+    if (r.thread >= per_thread.size())
+      per_thread.resize(r.thread+1);
+    ++per_thread[r.thread];
+    ++n;
+  }
+  EXPECT_EQ(kThreads*kEvents, n);
+  EXPECT_EQ(kThreads, int(std::count_if(per_thread.begin(), per_thread.end(),
+                                        [](int v){ return v == kEvents; })));
+
+  // Records that don't fit are dropped
+  {
+    obs::journal_writer journal(path, 256);
+    obs::scoped_connection c = journal.record(sig, 1);
+    for (int i=0; i<100; ++i)
+      sig(i);
+    EXPECT_TRUE(journal.dropped() > 0);
+    EXPECT_EQ(100u, journal.records() + journal.dropped());
+    EXPECT_TRUE(journal.size() <= journal.capacity());
+  }
+  reader.open(path);
+  n = 0;
+  for (const obs::journal_record& r : reader) {
+    EXPECT_EQ(sizeof(int), r.payload_size);
+    ++n;
+  }
+  EXPECT_TRUE(n > 0 && n < 100);
+
+  std::remove(path.c_str());
+}
+
+void test_invalid_file() {
+  const std::string path = temp_path("invalid");
+  std::FILE* f = std::fopen(path.c_str(), "wb");
+  std::fputs("not a journal file", f);
+  std::fclose(f);
+
+  obs::journal_reader reader;
+  EXPECT_FALSE(reader.open(path));
+  EXPECT_FALSE(reader.is_open());
+  EXPECT_TRUE(reader.begin() == reader.end());
+  EXPECT_FALSE(reader.open(temp_path("missing")));
+
+  std::remove(path.c_str());
+}
+
+int main() {
+  test_record_and_replay();
+  test_recorded_speed();
+  test_threads_and_capacity();
+  test_invalid_file();
+}
@@ -0,0 +1,130 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/observers.h"
+#include "obs/signal.h"
+#include "test.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef OBSERVABLE_METRICS
+  #error OBSERVABLE_METRICS must be defined to compile this test
+#endif
+
+struct Observer {
+  int count = 0;
+  void on_event() { ++count; }
+};
+
+int main() {
+  // Histogram buckets
+  for (std::uint64_t v : { 0, 1, 3, 4, 5, 7, 8, 100, 1000, 123456789 }) {
+    int i = obs::histogram::bucket_index(v);
+    EXPECT_TRUE(obs::histogram::bucket_value(i) <= v);
+    EXPECT_TRUE(i+1 == obs::histogram::buckets ||
+                v < obs::histogram::bucket_value(i+1));
+  }
+
+  {
+    obs::signal<void(int)> sig;
+    obs::scoped_connection a = sig.connect([](int){ });
+    obs::scoped_connection b = sig.connect([](int){ });
+
+    std::vector<std::thread> threads;
+    for (int i=0; i<4; ++i)
+      threads.emplace_back([&sig]{
+                             for (int j=0; j<100; ++j)
+                               sig(j);
+                           });
+    for (auto& t : threads)
+      t.join();
+
+    obs::metrics_snapshot s = sig.metrics().snapshot();
+    EXPECT_EQ(400u, s.emits);
+    EXPECT_EQ(800u, s.slot_calls);
+    EXPECT_EQ(400u, s.emit_histogram.total());
+    EXPECT_TRUE(s.emit_histogram.percentile(50) <= s.emit_histogram.percentile(99));
+
+    sig.metrics().reset();
+    s = sig.metrics().snapshot();
+    EXPECT_EQ(0u, s.emits);
+    EXPECT_EQ(0u, s.slot_calls);
+    EXPECT_EQ(0u, s.emit_histogram.total());
+
+    // Blocked slots are not counted
+    obs::connection c = sig.connect([](int){ });
+    c.block();
+    sig(1);
+    EXPECT_EQ(2u, sig.metrics().snapshot().slot_calls);
+    c.disconnect();
+  }
+
+  {
+    obs::observers<Observer> obs;
+    Observer a, b;
+    obs.add_observer(&a);
+    obs.add_observer(&b);
+    obs.notify_observers(&Observer::on_event);
+    obs.notify_observers(&Observer::on_event);
+
+    obs::metrics_snapshot s = obs.metrics().snapshot();
+    EXPECT_EQ(2u, s.emits);
+    EXPECT_EQ(4u, s.slot_calls);
+  }
+
+  // Recursion depth
+  {
+    obs::signal<void(int)> sig;
+    obs::scoped_connection c =
+      sig.connect([&sig](int n){
+                    if (n > 0)
+                      sig(n-1);
+                  });
+    sig(4);
+    obs::metrics_snapshot s = sig.metrics().snapshot();
+    EXPECT_EQ(5u, s.emits);
+    EXPECT_EQ(5, s.max_depth);
+  }
+
+  // Report of named signals
+  {
+    obs::signal<void()> cheap, expensive, unnamed;
+    cheap.set_name("cheap");
+    expensive.set_name("expensive \"one\"");
+    obs::scoped_connection c1 = cheap.connect([]{ });
+    obs::scoped_connection c2 =
+      expensive.connect([]{
+                          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                        });
+    obs::scoped_connection c3 = unnamed.connect([]{ });
+    cheap();
+    expensive();
+    unnamed();
+
+    auto top = obs::metrics_registry::instance().top(10);
+    EXPECT_EQ(2u, top.size());
+    EXPECT_EQ("expensive \"one\"", top[0].name);
+    EXPECT_EQ("cheap", top[1].name);
+
+    std::ostringstream text;
+    obs::report_metrics(text, obs::report_format::text, 1);
+    EXPECT_TRUE(text.str().find("expensive") != std::string::npos);
+    EXPECT_TRUE(text.str().find("cheap") == std::string::npos);
+
+    std::ostringstream json;
+    obs::report_metrics(json, obs::report_format::json);
+    EXPECT_TRUE(json.str().find("\"name\":\"expensive \\\"one\\\"\"") != std::string::npos);
+    EXPECT_TRUE(json.str().find("\"name\":\"cheap\"") != std::string::npos);
+
+    cheap.set_name("");
+    EXPECT_EQ(1u, obs::metrics_registry::instance().top(10).size());
+  }
+  EXPECT_EQ(0u, obs::metrics_registry::instance().top(10).size());
+}
@@ -0,0 +1,217 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/observable_map.h"
+#include "obs/observable_vector.h"
+#include "test.h"
+
+#include <string>
+#include <vector>
+
+static std::string to_string(const obs::vector_diff& diff) {
+  std::string s;
+  for (const auto& c : diff) {
+    s += (c.type == obs::vector_change::insert ? "+":
+          c.type == obs::vector_change::erase ? "-": "=");
+    s += std::to_string(c.first) + ":" + std::to_string(c.count) + " ";
+  }
+  return s;
+}
+
+// Applies the diff to a copy of the vector (to check that the copy is
+// equal to the observed vector after each notification).
+template<typename T>
+static void apply(std::vector<T>& copy,
+                  const obs::observable_vector<T>& v,
+                  const obs::vector_diff& diff) {
+  // Elements are taken from the observed vector, so we have to know
+  // where each inserted/updated range is in the final vector. The
+  // diffs in these tests don't move the ranges after they are
+  // inserted/updated.
+  for (const auto& c : diff) {
+    switch (c.type) {
+      case obs::vector_change::insert:
+        copy.insert(copy.begin()+c.first, c.count, T());
+        break;
+      case obs::vector_change::erase:
+        copy.erase(copy.begin()+c.first, copy.begin()+c.last());
+        break;
+      case obs::vector_change::update:
+        break;
+    }
+  }
+  for (const auto& c : diff) {
+    if (c.type != obs::vector_change::erase)
+      for (std::size_t i=c.first; i<c.last(); ++i)
+        copy[i] = v[i];
+  }
+}
+
+void test_vector() {
+  obs::observable_vector<int> v;
+  std::vector<int> copy;
+  std::string log;
+  int notifications = 0;
+  obs::scoped_connection c =
+    v.changed.connect([&](const obs::vector_diff& diff) {
+                        ++notifications;
+                        log = to_string(diff);
+                        apply(copy, v, diff);
+                      });
+
+  v.push_back(1);
+  EXPECT_EQ("+0:1 ", log);
+  v.insert(0, { 5, 6, 7 });
+  EXPECT_EQ("+0:3 ", log);
+  v.set(2, 8);
+  EXPECT_EQ("=2:1 ", log);
+  v.erase(1, 3);
+  EXPECT_EQ("-1:2 ", log);
+  v.update(0, 2, [](int& x){ x *= 10; });
+  EXPECT_EQ("=0:2 ", log);
+  EXPECT_EQ(5, notifications);
+  EXPECT_TRUE(copy == v.items());
+
+  v.clear();
+  EXPECT_EQ("-0:2 ", log);
+  v.clear();
+  EXPECT_EQ(6, notifications);
+  EXPECT_TRUE(copy.empty());
+}
+
+// A transaction notifies all the changes at once (merging adjacent
+// ranges).
+void test_vector_transaction() {
+  obs::observable_vector<int> v;
+  std::vector<int> copy;
+  std::string log;
+  int notifications = 0;
+  obs::scoped_connection c =
+    v.changed.connect([&](const obs::vector_diff& diff) {
+                        ++notifications;
+                        log = to_string(diff);
+                        apply(copy, v, diff);
+                      });
+  {
+    obs::observable_vector<int>::transaction t(v);
+    for (int i=0; i<1000; ++i)
+      v.push_back(i);
+    v.set(10, -1);
+    {
+      obs::observable_vector<int>::transaction t2(v);
+      v.insert(500, 42);
+    }
+    EXPECT_EQ(0, notifications);
+    EXPECT_TRUE(v.in_transaction());
+  }
+  EXPECT_EQ(1, notifications);
+  EXPECT_EQ("+0:1001 ", log);
+  EXPECT_TRUE(copy == v.items());
+
+  {
+    obs::observable_vector<int>::transaction t(v);
+    v.set(5, 0);
+    v.set(6, 0);
+    v.set(4, 0);
+    for (int i=0; i<10; ++i)
+      v.pop_back();
+    v.erase(900);
+    v.erase(900);
+  }
+  EXPECT_EQ(2, notifications);
+  EXPECT_EQ("=4:3 -991:10 -900:2 ", log);
+  EXPECT_TRUE(copy == v.items());
+
+  // Assignment: erase + insert in one notification
+  obs::observable_vector<int> other = { 1, 2, 3 };
+  v = other;
+  EXPECT_EQ(3, notifications);
+  EXPECT_EQ("-0:989 +0:3 ", log);
+  EXPECT_TRUE(copy == v.items());
+}
+
+// Slots can modify the vector (nested notification).
+void test_vector_nested() {
+  obs::observable_vector<int> v;
+  std::string log;
+  obs::scoped_connection c =
+    v.changed.connect([&](const obs::vector_diff& diff) {
+                        log += to_string(diff);
+                        if (v.size() < 3)
+                          v.push_back(0);
+                      });
+  v.push_back(0);
+  EXPECT_EQ("+0:1 +1:1 +2:1 ", log);
+}
+
+template<typename Diff>
+static std::string keys(const Diff& diff) {
+  std::string s;
+  for (const auto& k : diff.inserted) s += "+" + k;
+  for (const auto& k : diff.erased) s += "-" + k;
+  for (const auto& k : diff.updated) s += "=" + k;
+  return s;
+}
+
+void test_map() {
+  using map_t = obs::observable_map<std::string, int>;
+  map_t m;
+  std::string log;
+  int notifications = 0;
+  obs::scoped_connection c =
+    m.changed.connect([&](const map_t::diff_type& diff) {
+                        ++notifications;
+                        log = keys(diff);
+                      });
+
+  EXPECT_TRUE(m.insert("a", 1));
+  EXPECT_EQ("+a", log);
+  EXPECT_FALSE(m.insert("a", 2));
+  EXPECT_EQ(1, notifications);
+  m.insert_or_assign("a", 3);
+  EXPECT_EQ("=a", log);
+  EXPECT_TRUE(m.update("a", [](int& v){ ++v; }));
+  EXPECT_EQ(4, m.at("a"));
+  EXPECT_FALSE(m.update("z", [](int& v){ ++v; }));
+  EXPECT_EQ(1u, m.erase("a"));
+  EXPECT_EQ("-a", log);
+  EXPECT_EQ(0u, m.erase("a"));
+  EXPECT_EQ(4, notifications);
+
+  {
+    map_t::transaction t(m);
+    m.insert("b", 1);
+    m.insert("c", 1);
+    m.insert("d", 1);
+    m.erase("c");         // Inserted and erased: nothing
+    m.update("b", [](int& v){ v = 2; });  // Still inserted
+    m.insert("a", 1);
+  }
+  EXPECT_EQ(5, notifications);
+  EXPECT_EQ("+a+b+d", log);
+
+  {
+    map_t::transaction t(m);
+    m.erase("a");
+    m.insert("a", 5);     // Erased and inserted: updated
+    m.erase("b");
+    m.insert_or_assign("e", 1);
+  }
+  EXPECT_EQ(6, notifications);
+  EXPECT_EQ("+e-b=a", log);
+
+  m.clear();
+  EXPECT_EQ(7, notifications);
+  EXPECT_EQ("-a-d-e", log);
+  EXPECT_TRUE(m.empty());
+}
+
+int main() {
+  test_vector();
+  test_vector_transaction();
+  test_vector_nested();
+  test_map();
+}
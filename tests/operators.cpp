@@ -0,0 +1,104 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/operators.h"
+#include "test.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+  {
+    obs::signal<void(int)> sig;
+    std::vector<int> values;
+    obs::scoped_connection c =
+      (obs::from(sig)
+       | obs::filter([](int x){ return (x % 2) == 0; })
+       | obs::map([](int x){ return x * 10; })
+       | obs::map([](int x){ return std::to_string(x); }))
+      .connect([&values](const std::string& s){ values.push_back(std::stoi(s)); });
+
+    for (int i=0; i<6; ++i)
+      sig(i);
+
+    EXPECT_EQ(3u, values.size());
+    EXPECT_EQ(0, values[0]);
+    EXPECT_EQ(20, values[1]);
+    EXPECT_EQ(40, values[2]);
+  }
+
+  // Multiple arguments are passed through filters
+  {
+    obs::signal<void(int, int)> sig;
+    int sum = 0;
+    obs::scoped_connection c =
+      (obs::from(sig)
+       | obs::filter([](int x, int y){ return x < y; })
+       | obs::map([](int x, int y){ return x + y; }))
+      .connect([&sum](int v){ sum += v; });
+
+    sig(1, 2);
+    sig(4, 3);
+    sig(5, 6);
+    EXPECT_EQ(14, sum);
+  }
+
+  // take_while() stops forever
+  {
+    obs::signal<void(int)> sig;
+    int count = 0;
+    obs::scoped_connection c =
+      (obs::from(sig)
+       | obs::take_while([](int x){ return x < 3; }))
+      .connect([&count](int){ ++count; });
+
+    sig(1);
+    sig(2);
+    sig(3);
+    sig(1);
+    EXPECT_EQ(2, count);
+  }
+
+  // throttle()
+  {
+    obs::signal<void()> sig;
+    int count = 0;
+    obs::scoped_connection c =
+      (obs::from(sig)
+       | obs::throttle(std::chrono::hours(1)))
+      .connect([&count]{ ++count; });
+
+    sig();
+    sig();
+    sig();
+    EXPECT_EQ(1, count);
+  }
+
+  // merge() shares the same pipeline between signals
+  {
+    obs::signal<void(int)> a;
+    obs::fast_signal<void(int)> b;
+    int count = 0;
+    std::vector<obs::connection> conns =
+      (obs::merge(a, b)
+       | obs::take_while([](int x){ return x > 0; }))
+      .connect([&count](int){ ++count; });
+    EXPECT_EQ(2u, conns.size());
+
+    a(1);
+    b(1);
+    b(0);
+    a(1);
+    EXPECT_EQ(2, count);
+
+    for (auto& conn : conns)
+      conn.disconnect();
+    EXPECT_FALSE(a);
+    EXPECT_FALSE(b);
+  }
+}
@@ -0,0 +1,184 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/queued_signal.h"
+#include "test.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+static bool readable(int fd, int timeout_ms = 0) {
+  pollfd p;
+  p.fd = fd;
+  p.events = POLLIN;
+  p.revents = 0;
+  return (::poll(&p, 1, timeout_ms) == 1 && (p.revents & POLLIN));
+}
+
+void test_drain() {
+  obs::queued_signal<void(int, std::string)> sig;
+  EXPECT_TRUE(sig.fd() >= 0);
+  EXPECT_FALSE(readable(sig.fd()));
+
+  std::string log;
+  obs::scoped_connection c =
+    sig.connect([&log](int v, const std::string& s) {
+                  log += std::to_string(v) + s;
+                });
+
+  // Slots are called only in drain()
+  sig(1, "a");
+  sig(2, "b");
+  sig(3, "c");
+  EXPECT_EQ("", log);
+  EXPECT_EQ(3u, sig.size());
+  EXPECT_TRUE(readable(sig.fd()));
+
+  // The fd is still readable if there are events in the queue
+  EXPECT_EQ(2u, sig.drain(2));
+  EXPECT_EQ("1a2b", log);
+  EXPECT_TRUE(readable(sig.fd()));
+
+  EXPECT_EQ(1u, sig.drain(2));
+  EXPECT_EQ("1a2b3c", log);
+  EXPECT_TRUE(sig.empty());
+  EXPECT_FALSE(readable(sig.fd()));
+
+  EXPECT_EQ(0u, sig.drain());
+  EXPECT_FALSE(readable(sig.fd()));
+
+  sig(4, "d");
+  EXPECT_TRUE(readable(sig.fd()));
+  EXPECT_EQ(1u, sig.drain());
+  EXPECT_EQ("1a2b3c4d", log);
+  EXPECT_FALSE(readable(sig.fd()));
+}
+
+// Slots can emit the same signal, events are delivered in the next
+// drain().
+void test_emit_from_slot() {
+  obs::queued_signal<void(int)> sig;
+  std::vector<int> values;
+  obs::scoped_connection c =
+    sig.connect([&](int v) {
+                  values.push_back(v);
+                  if (v > 0)
+                    sig(v-1);
+                });
+  sig(2);
+  EXPECT_EQ(1u, sig.drain());
+  EXPECT_TRUE(readable(sig.fd()));
+  EXPECT_EQ(1u, sig.drain());
+  EXPECT_EQ(1u, sig.drain());
+  EXPECT_EQ(0u, sig.drain());
+  EXPECT_EQ(3u, values.size());
+  EXPECT_EQ(0, values[2]);
+}
+
+struct Counter {
+  int n = 0;
+  void add(int v) { n += v; }
+};
+
+// Events emitted from several threads delivered in an event loop.
+void test_threads() {
+  const int kThreads = 4;
+  const int kEvents = 1000;
+
+  obs::queued_signal<void(int)> sig;
+  Counter counter;
+  obs::scoped_connection c = sig.connect(&Counter::add, &counter);
+
+  std::vector<std::thread> threads;
+  for (int i=0; i<kThreads; ++i)
+    threads.emplace_back([&sig]{
+                           for (int j=0; j<kEvents; ++j)
+                             sig(1);
+                         });
+
+  int received = 0;
+  while (received < kThreads*kEvents) {
+    EXPECT_TRUE(readable(sig.fd(), 10000));
+    received += int(sig.drain(64));
+  }
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(kThreads*kEvents, counter.n);
+  EXPECT_EQ(0u, sig.drain());
+  EXPECT_FALSE(readable(sig.fd()));
+}
+
+// A bounded queue applies its overflow policy when it's full.
+void test_bounded() {
+  obs::queued_signal<void(int)> sig(4, obs::overflow::drop_oldest);
+  EXPECT_EQ(4u, sig.capacity());
+
+  std::string log;
+  obs::scoped_connection c =
+    sig.connect([&log](int v) { log += std::to_string(v); });
+
+  for (int i=0; i<6; ++i)
+    sig(i);
+  EXPECT_EQ(4u, sig.size());
+  EXPECT_EQ(2u, sig.dropped());
+  EXPECT_TRUE(readable(sig.fd()));
+
+  EXPECT_EQ(3u, sig.drain(3));
+  EXPECT_EQ("234", log);
+  EXPECT_TRUE(readable(sig.fd()));
+  EXPECT_EQ(1u, sig.drain());
+  EXPECT_EQ("2345", log);
+  EXPECT_FALSE(readable(sig.fd()));
+
+  // Discarded events don't signal the fd
+  obs::queued_signal<void(int)> sig2(2, obs::overflow::drop_newest);
+  sig2(1);
+  sig2(2);
+  EXPECT_EQ(2u, sig2.drain());
+  EXPECT_FALSE(readable(sig2.fd()));
+}
+
+// Producers wait while the bounded queue is full.
+void test_bounded_threads() {
+  const int kThreads = 4;
+  const int kEvents = 1000;
+
+  obs::queued_signal<void(int)> sig(16, obs::overflow::block);
+  Counter counter;
+  obs::scoped_connection c = sig.connect(&Counter::add, &counter);
+
+  std::vector<std::thread> threads;
+  for (int i=0; i<kThreads; ++i)
+    threads.emplace_back([&sig]{
+                           for (int j=0; j<kEvents; ++j)
+                             sig(1);
+                         });
+
+  int received = 0;
+  while (received < kThreads*kEvents) {
+    EXPECT_TRUE(readable(sig.fd(), 10000));
+    received += int(sig.drain(8));
+  }
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(kThreads*kEvents, counter.n);
+  EXPECT_EQ(0u, sig.dropped());
+  EXPECT_EQ(0u, sig.drain());
+  EXPECT_FALSE(readable(sig.fd()));
+}
+
+int main() {
+  test_drain();
+  test_emit_from_slot();
+  test_threads();
+  test_bounded();
+  test_bounded_threads();
+}
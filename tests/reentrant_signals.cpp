@@ -0,0 +1,173 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+template<typename Signal>
+void test_allow() {
+  Signal sig;
+  std::string log;
+  obs::scoped_connection c =
+    sig.connect([&](int i){
+                  log += "(" + std::to_string(i);
+                  if (i > 0)
+                    sig(i-1);
+                  log += ")";
+                });
+  sig(2);
+  EXPECT_EQ("(2(1(0)))", log);
+  EXPECT_EQ(0u, sig.deferred_emissions());
+  EXPECT_EQ(0u, sig.skipped_emissions());
+}
+
+template<typename Signal>
+void test_limit() {
+  Signal sig;
+  sig.set_reentrancy(obs::reentrancy::limit, 2);
+  EXPECT_TRUE(obs::reentrancy::limit == sig.reentrancy_mode());
+
+  std::string log;
+  obs::scoped_connection c =
+    sig.connect([&](int i){
+                  log += "(" + std::to_string(i);
+                  if (i > 0)
+                    sig(i-1);
+                  log += ")";
+                });
+  sig(3);
+  EXPECT_EQ("(3(2))", log);
+  EXPECT_EQ(1u, sig.skipped_emissions());
+
+  // The depth is counted again in each outermost emission
+  log.clear();
+  sig(1);
+  EXPECT_EQ("(1(0))", log);
+  EXPECT_EQ(1u, sig.skipped_emissions());
+}
+
+// Nested emissions are emitted iteratively after the outermost one.
+template<typename Signal>
+void test_defer() {
+  Signal sig;
+  sig.set_reentrancy(obs::reentrancy::defer);
+
+  std::string log;
+  obs::scoped_connection a =
+    sig.connect([&](int i){
+                  log += "(" + std::to_string(i);
+                  if (i > 0) {
+                    sig(i-1);
+                    sig(i-1);
+                  }
+                  log += ")";
+                });
+  obs::scoped_connection b =
+    sig.connect([&](int i){ log += "b" + std::to_string(i); });
+
+  sig(2);
+  EXPECT_EQ("(2)b2(1)b1(1)b1(0)b0(0)b0(0)b0(0)b0", log);
+  EXPECT_EQ(6u, sig.deferred_emissions());
+  EXPECT_EQ(0u, sig.skipped_emissions());
+}
+
+// A long cascade doesn't grow the stack.
+void test_deep_defer() {
+  obs::signal<void(int)> sig;
+  sig.set_reentrancy(obs::reentrancy::defer);
+
+  int calls = 0;
+  int max_depth = 0, depth = 0;
+  obs::scoped_connection c =
+    sig.connect([&](int i){
+                  ++calls;
+                  max_depth = std::max(max_depth, ++depth);
+                  if (i > 0)
+                    sig(i-1);
+                  --depth;
+                });
+  sig(100000);
+  EXPECT_EQ(100001, calls);
+  EXPECT_EQ(1, max_depth);
+  EXPECT_EQ(100000u, sig.deferred_emissions());
+}
+
+// Each signal defers only its own nested emissions, even when they
+// are emitted through other signals.
+void test_other_signals() {
+  obs::signal<void(int)> a, b;
+  a.set_reentrancy(obs::reentrancy::defer);
+  b.set_reentrancy(obs::reentrancy::defer);
+
+  std::string log;
+  obs::scoped_connection ca =
+    a.connect([&](int i){
+                log += "a" + std::to_string(i);
+                if (i > 0)
+                  b(i-1);
+              });
+  obs::scoped_connection cb =
+    b.connect([&](int i){
+                log += "b" + std::to_string(i);
+                if (i > 0)
+                  a(i-1);
+              });
+  a(3);
+  EXPECT_EQ("a3b2a1b0", log);
+  EXPECT_EQ(1u, a.deferred_emissions());
+  EXPECT_EQ(0u, b.deferred_emissions());
+}
+
+// Signals with results skip nested emissions in "defer" mode.
+void test_result() {
+  obs::signal<int(int)> sig;
+  sig.set_reentrancy(obs::reentrancy::defer);
+
+  obs::scoped_connection c =
+    sig.connect([&](int i){
+                  return (i > 0 ? 1 + sig(i-1): 0);
+                });
+  EXPECT_EQ(1, sig(5));
+  EXPECT_EQ(1u, sig.skipped_emissions());
+
+  sig.set_reentrancy(obs::reentrancy::limit, 3);
+  EXPECT_EQ(3, sig(5));
+  EXPECT_EQ(2u, sig.skipped_emissions());
+}
+
+// Non-copyable arguments cannot be deferred.
+void test_non_copyable() {
+  obs::signal<void(std::unique_ptr<int>)> sig;
+  sig.set_reentrancy(obs::reentrancy::defer);
+
+  int calls = 0;
+  obs::scoped_connection c =
+    sig.connect([&](std::unique_ptr<int> p){
+                  ++calls;
+                  if (*p > 0)
+                    sig(std::unique_ptr<int>(new int(*p-1)));
+                });
+  sig(std::unique_ptr<int>(new int(2)));
+  EXPECT_EQ(3, calls);
+  EXPECT_EQ(0u, sig.deferred_emissions());
+}
+
+int main() {
+  test_allow<obs::safe_signal<void(int)>>();
+  test_allow<obs::fast_signal<void(int)>>();
+  test_limit<obs::safe_signal<void(int)>>();
+  test_limit<obs::fast_signal<void(int)>>();
+  test_defer<obs::safe_signal<void(int)>>();
+  test_defer<obs::fast_signal<void(int)>>();
+  test_deep_defer();
+  test_other_signals();
+  test_result();
+  test_non_copyable();
+}
@@ -0,0 +1,179 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/ring_queue.h"
+#include "alloc_counter.h"
+#include "test.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string pop_all(obs::ring_queue<int>& q) {
+  std::string s;
+  int v;
+  while (q.try_pop(v))
+    s += std::to_string(v);
+  return s;
+}
+
+void test_capacity() {
+  obs::ring_queue<int> a(1), b(4), c(5);
+  EXPECT_EQ(2u, a.capacity());
+  EXPECT_EQ(4u, b.capacity());
+  EXPECT_EQ(8u, c.capacity());
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(obs::overflow::block == a.policy());
+}
+
+void test_fifo() {
+  obs::ring_queue<int> q(4);
+  int v = 0;
+  EXPECT_FALSE(q.try_pop(v));
+
+  // Wraps around the ring several times
+  for (int i=0; i<10; ++i) {
+    EXPECT_TRUE(q.try_push(i));
+    EXPECT_TRUE(q.try_push(i+1));
+    EXPECT_EQ(2u, q.size());
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(i, v);
+    EXPECT_TRUE(q.try_pop(v));
+    EXPECT_EQ(i+1, v);
+  }
+  EXPECT_TRUE(q.empty());
+
+  for (int i=0; i<4; ++i)
+    EXPECT_TRUE(q.try_push(i));
+  EXPECT_FALSE(q.try_push(4));
+  EXPECT_EQ("0123", pop_all(q));
+}
+
+void test_drop_newest() {
+  obs::ring_queue<int> q(4, obs::overflow::drop_newest);
+  for (int i=0; i<6; ++i)
+    EXPECT_EQ(i < 4, q.push(i));
+  EXPECT_EQ(2u, q.dropped());
+  EXPECT_EQ("0123", pop_all(q));
+}
+
+void test_drop_oldest() {
+  obs::ring_queue<int> q(4, obs::overflow::drop_oldest);
+  for (int i=0; i<7; ++i)
+    EXPECT_TRUE(q.push(i));
+  EXPECT_EQ(3u, q.dropped());
+  EXPECT_EQ("3456", pop_all(q));
+}
+
+// Only the latest element is kept while the queue is full, and it's
+// popped after the elements in the ring.
+void test_coalesce() {
+  obs::ring_queue<int> q(4, obs::overflow::coalesce);
+  for (int i=0; i<7; ++i)
+    EXPECT_TRUE(q.push(i));
+  EXPECT_EQ(5u, q.size());
+  EXPECT_EQ(2u, q.dropped());
+
+  // The coalesced element goes back to the ring when there is space
+  int v;
+  EXPECT_TRUE(q.try_pop(v));
+  EXPECT_EQ(0, v);
+  EXPECT_TRUE(q.push(7));
+  EXPECT_EQ(2u, q.dropped());
+  EXPECT_EQ("12367", pop_all(q));
+
+  EXPECT_TRUE(q.push(8));
+  EXPECT_EQ("8", pop_all(q));
+}
+
+// A consumer that drains the queue partially doesn't lose the
+// elements pushed after that (only while the ring is full).
+void test_coalesce_partial_drain() {
+  obs::ring_queue<int> q(4, obs::overflow::coalesce);
+  for (int i=0; i<6; ++i)
+    EXPECT_TRUE(q.push(i));
+  EXPECT_EQ(1u, q.dropped());
+
+  int v;
+  EXPECT_TRUE(q.try_pop(v));
+  EXPECT_TRUE(q.try_pop(v));
+  EXPECT_EQ(1, v);
+
+  EXPECT_TRUE(q.push(6));
+  EXPECT_TRUE(q.push(7));
+  EXPECT_EQ(1u, q.dropped());
+  EXPECT_EQ(5u, q.size());
+  EXPECT_TRUE(q.try_pop(v));
+  EXPECT_TRUE(q.push(8));
+  EXPECT_TRUE(q.push(9));
+  EXPECT_EQ(2u, q.dropped());
+  EXPECT_EQ("35679", pop_all(q));
+}
+
+// A full queue blocks the producer until the consumer pops elements.
+void test_block() {
+  const int kProducers = 4;
+  const int kElements = 5000;
+
+  obs::ring_queue<int> q(8, obs::overflow::block);
+  std::vector<std::thread> threads;
+  for (int i=0; i<kProducers; ++i)
+    threads.emplace_back([&q]{
+                           for (int j=1; j<=kElements; ++j)
+                             q.push(j);
+                         });
+
+  long long sum = 0;
+  int received = 0;
+  int v;
+  while (received < kProducers*kElements) {
+    if (q.try_pop(v)) {
+      sum += v;
+      ++received;
+    }
+    else
+      std::this_thread::yield();
+  }
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(kProducers * (long long)kElements*(kElements+1)/2, sum);
+  EXPECT_EQ(0u, q.dropped());
+  EXPECT_TRUE(q.empty());
+}
+
+// Pushing and popping doesn't allocate memory in the steady state.
+void test_no_allocations() {
+  obs::ring_queue<std::string> q(4, obs::overflow::coalesce);
+  const std::string value = "abc";
+  std::string out;
+
+  // Warm up (the coalesced element is allocated the first time)
+  for (int i=0; i<5; ++i)
+    q.push(value);
+  while (q.try_pop(out))
+    ;
+
+  alloc_counter::scope allocs;
+  for (int j=0; j<100; ++j) {
+    for (int i=0; i<6; ++i)
+      q.push(value);
+    while (q.try_pop(out))
+      ;
+  }
+  EXPECT_EQ(0u, allocs.allocs());
+}
+
+int main() {
+  test_capacity();
+  test_fifo();
+  test_drop_newest();
+  test_drop_oldest();
+  test_coalesce();
+  test_coalesce_partial_drain();
+  test_block();
+  test_no_allocations();
+}
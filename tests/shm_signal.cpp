@@ -0,0 +1,271 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/shm_signal.h"
+#include "test.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct point {
+  int x, y;
+};
+
+using event_signal = obs::shm_signal<void(int, point)>;
+using ready_signal = obs::shm_signal<void(int)>;
+
+const int kChildren = 3;
+const int kEvents = 1000;
+
+static std::string shm_name(const char* suffix) {
+  return "/obs_test_" + std::to_string(int(getpid())) + suffix;
+}
+
+// Events are dispatched in the same process too.
+void test_local() {
+  const std::string name = shm_name("_local");
+  event_signal sig(name, 16);
+  EXPECT_TRUE(sig.is_open());
+
+  int sum = 0;
+  obs::scoped_connection c =
+    sig.connect([&](const int& v, const point& pt) {
+                  sum += v + pt.x + pt.y;
+                });
+
+  EXPECT_FALSE(sig.pending());
+  sig(1, point{ 2, 3 });
+  sig(4, point{ 5, 6 });
+  EXPECT_TRUE(sig.pending());
+  EXPECT_EQ(0, sum);
+  EXPECT_EQ(1u, sig.dispatch(1));
+  EXPECT_EQ(6, sum);
+  EXPECT_EQ(1u, sig.dispatch());
+  EXPECT_EQ(21, sum);
+  EXPECT_EQ(0u, sig.dispatch());
+
+  // Other instance in the same process (it sees only new events)
+  event_signal sig2(name, 16);
+  EXPECT_TRUE(sig2.is_open());
+  int count2 = 0;
+  obs::scoped_connection c2 = sig2.connect([&](int, point){ ++count2; });
+  sig2(7, point{ 0, 0 });
+  EXPECT_EQ(1u, sig.dispatch());
+  EXPECT_EQ(1u, sig2.dispatch());
+  EXPECT_EQ(28, sum);
+  EXPECT_EQ(1, count2);
+
+  // Different arguments or capacity cannot open the same segment
+  ready_signal other(name, 16);
+  EXPECT_FALSE(other.is_open());
+  event_signal other2(name, 64);
+  EXPECT_FALSE(other2.is_open());
+
+  EXPECT_TRUE(event_signal::unlink(name));
+}
+
+// Events that are overwritten before they are dispatched are lost.
+void test_dropped() {
+  const std::string name = shm_name("_dropped");
+  obs::shm_signal<void(int)> sig(name, 8);
+  EXPECT_TRUE(sig.is_open());
+
+  int first = -1, count = 0;
+  obs::scoped_connection c =
+    sig.connect([&](int v){
+                  if (first < 0)
+                    first = v;
+                  ++count;
+                });
+  for (int i=0; i<20; ++i)
+    sig(i);
+  EXPECT_EQ(8u, sig.dispatch());
+  EXPECT_EQ(12, first);
+  EXPECT_EQ(8, count);
+  EXPECT_EQ(12u, sig.dropped());
+
+  EXPECT_TRUE(obs::shm_signal<void(int)>::unlink(name));
+}
+
+// An event that is overwritten while it's dispatched (here by its own
+// slot) is not torn, the slots receive a copy of the arguments.
+void test_overwrite_in_dispatch() {
+  const std::string name = shm_name("_overwrite");
+  event_signal sig(name, 4);
+  EXPECT_TRUE(sig.is_open());
+
+  std::vector<int> seen;
+  obs::scoped_connection c =
+    sig.connect([&](const int& v, const point& pt){
+                  if (seen.empty()) {
+                    for (int i=0; i<8; ++i)
+                      sig(100+i, point{ 100+i, 100+i });
+                  }
+                  EXPECT_EQ(v, pt.x);
+                  EXPECT_EQ(v, pt.y);
+                  seen.push_back(v);
+                });
+  sig(1, point{ 1, 1 });
+  sig(2, point{ 2, 2 });
+  EXPECT_EQ(5u, sig.dispatch());
+  EXPECT_EQ(5u, sig.dropped());
+  EXPECT_EQ(5u, seen.size());
+  EXPECT_EQ(1, seen[0]);
+  EXPECT_EQ(104, seen[1]);
+  EXPECT_EQ(107, seen[4]);
+
+  EXPECT_TRUE(event_signal::unlink(name));
+}
+
+// A slot can dispatch the next events, its own arguments are not
+// overwritten by the nested dispatch().
+void test_nested_dispatch() {
+  const std::string name = shm_name("_nested");
+  event_signal sig(name, 16);
+  EXPECT_TRUE(sig.is_open());
+
+  std::vector<int> seen;
+  obs::scoped_connection c =
+    sig.connect([&](const int& v, const point& pt){
+                  if (v == 1)
+                    EXPECT_EQ(2u, sig.dispatch());
+                  EXPECT_EQ(v, pt.x);
+                  EXPECT_EQ(v, pt.y);
+                  seen.push_back(v);
+                });
+  sig(1, point{ 1, 1 });
+  sig(2, point{ 2, 2 });
+  sig(3, point{ 3, 3 });
+  EXPECT_EQ(1u, sig.dispatch());
+  EXPECT_EQ(3u, seen.size());
+  EXPECT_EQ(2, seen[0]);
+  EXPECT_EQ(3, seen[1]);
+  EXPECT_EQ(1, seen[2]);
+
+  EXPECT_TRUE(event_signal::unlink(name));
+}
+
+// Emitters in different threads that write the same entry of the
+// ring buffer don't mix their arguments.
+void test_writers() {
+  const std::string name = shm_name("_writers");
+  event_signal sig(name, 4);
+  EXPECT_TRUE(sig.is_open());
+
+  int count = 0;
+  obs::scoped_connection c =
+    sig.connect([&](const int& v, const point& pt){
+                  EXPECT_EQ(v, pt.x);
+                  EXPECT_EQ(-v, pt.y);
+                  ++count;
+                });
+
+  std::vector<std::thread> threads;
+  for (int i=0; i<4; ++i)
+    threads.push_back(
+      std::thread([&sig, i]{
+                    for (int j=0; j<kEvents; ++j) {
+                      const int v = i*kEvents + j;
+                      sig(v, point{ v, -v });
+                    }
+                  }));
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(4u, sig.dispatch());
+  EXPECT_EQ(4, count);
+  EXPECT_EQ(std::uint64_t(4*kEvents - 4), sig.dropped());
+
+  EXPECT_TRUE(event_signal::unlink(name));
+}
+
+// Child process: subscribes to the events, notifies that it's ready,
+// and receives events until the last one (v == -1).
+static int child_main(const std::string& events_name,
+                      const std::string& ready_name, int id) {
+  event_signal events(events_name, 4096);
+  ready_signal ready(ready_name, 64);
+  if (!events.is_open() || !ready.is_open())
+    return 2;
+
+  std::int64_t sum = 0;
+  int count = 0;
+  bool done = false;
+  obs::scoped_connection c =
+    events.connect([&](int v, const point& pt) {
+                     if (v < 0) {
+                       done = true;
+                       return;
+                     }
+                     sum += v + pt.x - pt.y;
+                     ++count;
+                   });
+  ready(id);
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!done && std::chrono::steady_clock::now() < deadline)
+    events.wait_and_dispatch(std::chrono::milliseconds(100));
+
+  const std::int64_t expected = std::int64_t(kEvents) * (kEvents-1) / 2;
+  return (done && count == kEvents && sum == expected &&
+          events.dropped() == 0 ? 0: 1);
+}
+
+void test_processes() {
+  const std::string events_name = shm_name("_events");
+  const std::string ready_name = shm_name("_ready");
+
+  event_signal events(events_name, 4096);
+  ready_signal ready(ready_name, 64);
+  EXPECT_TRUE(events.is_open());
+  EXPECT_TRUE(ready.is_open());
+
+  int ready_children = 0;
+  obs::scoped_connection c = ready.connect([&](int){ ++ready_children; });
+
+  pid_t pids[kChildren];
+  for (int i=0; i<kChildren; ++i) {
+    pids[i] = fork();
+    if (pids[i] == 0)
+      _exit(child_main(events_name, ready_name, i));
+    EXPECT_TRUE(pids[i] > 0);
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (ready_children < kChildren &&
+         std::chrono::steady_clock::now() < deadline)
+    ready.wait_and_dispatch(std::chrono::milliseconds(100));
+  EXPECT_EQ(kChildren, ready_children);
+
+  for (int i=0; i<kEvents; ++i)
+    events(i, point{ i, i });
+  events(-1, point{ 0, 0 });
+
+  for (int i=0; i<kChildren; ++i) {
+    int status = 0;
+    EXPECT_EQ(pids[i], waitpid(pids[i], &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+  }
+
+  event_signal::unlink(events_name);
+  ready_signal::unlink(ready_name);
+}
+
+int main() {
+  test_local();
+  test_dropped();
+  test_overwrite_in_dispatch();
+  test_nested_dispatch();
+  test_writers();
+  test_processes();
+}
@@ -0,0 +1,69 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <string>
+
+struct Cache {
+  std::string* log;
+  void invalidate() { *log += "c"; }
+};
+
+template<typename Signal>
+void test_priorities() {
+  Signal sig;
+  std::string log;
+  Cache cache = { &log };
+  obs::scoped_connection a = sig.connect([&log]{ log += "a"; });
+  obs::scoped_connection b = sig.connect(-1, [&log]{ log += "b"; });
+  obs::scoped_connection c = sig.connect(10, &Cache::invalidate, &cache);
+  obs::scoped_connection d = sig.connect([&log]{ log += "d"; });
+  obs::scoped_connection e = sig.connect(10, [&log]{ log += "e"; });
+
+  sig();
+  EXPECT_EQ("ceadb", log);
+
+  // Order is kept after disconnections
+  log.clear();
+  e.disconnect();
+  a.disconnect();
+  obs::scoped_connection f = sig.connect(5, [&log]{ log += "f"; });
+  sig();
+  EXPECT_EQ("cfdb", log);
+}
+
+// Connect slots with different priorities in the same emission
+template<typename Signal>
+void test_connect_on_signal() {
+  Signal sig;
+  std::string log;
+  obs::scoped_connection a, b, c;
+  bool connected = false;
+  a = sig.connect([&]{
+                    log += "a";
+                    if (!connected) {
+                      connected = true;
+                      b = sig.connect(1, [&log]{ log += "b"; });
+                      c = sig.connect(-1, [&log]{ log += "c"; });
+                    }
+                  });
+
+  sig();
+  EXPECT_EQ('a', log[0]);
+
+  log.clear();
+  sig();
+  EXPECT_EQ("bac", log);
+}
+
+int main() {
+  test_priorities<obs::safe_signal<void()>>();
+  test_priorities<obs::fast_signal<void()>>();
+  test_connect_on_signal<obs::safe_signal<void()>>();
+  test_connect_on_signal<obs::fast_signal<void()>>();
+}
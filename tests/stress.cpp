@@ -0,0 +1,304 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+// Stress test mixing emitters, connectors, and disconnectors at
+// different ratios. It reports the throughput, emit/disconnect
+// latencies, and the max time that erase() waited other threads.
+//
+// Usage:
+//
+//   stress [--target=all|safe_signal|fast_signal|safe_observers|fast_observers]
+//          [--threads=N] [--duration=seconds] [--slots=N]
+//          [--emit=weight] [--connect=weight] [--disconnect=weight]
+//
+// Targets with a fast_list are not thread-safe, so they are always
+// tested with just one thread.
+//
+// It's compiled with OBSERVABLE_METRICS to get the erase() waits.
+
+#include "obs.h"
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+struct options {
+  std::string target = "all";
+  int threads = std::max<int>(2, std::thread::hardware_concurrency());
+  double duration = 0.25;
+  int slots = 16;
+  int emit = 90;
+  int connect = 5;
+  int disconnect = 5;
+};
+
+// Object connected to a signal (or added as an observer). It must
+// not be called after it's disconnected.
+class receiver {
+public:
+  receiver() : m_alive(true) { }
+
+  ~receiver() {
+    m_alive = false;
+  }
+
+  void on_event(int value) {
+    EXPECT_TRUE(m_alive.load(std::memory_order_relaxed));
+    (void)value;
+  }
+
+private:
+  std::atomic<bool> m_alive;
+};
+
+struct subscription {
+  receiver* recv;
+  obs::connection conn;
+};
+
+template<typename Signal>
+struct signal_target {
+  Signal sig;
+
+  void connect(subscription& s) {
+    s.conn = sig.connect(&receiver::on_event, s.recv);
+  }
+
+  void disconnect(subscription& s) {
+    s.conn.disconnect();
+  }
+
+  void emit(int value) {
+    sig(value);
+  }
+};
+
+template<typename Observers>
+struct observers_target {
+  Observers obs;
+
+  void connect(subscription& s) {
+    obs.add_observer(s.recv);
+  }
+
+  void disconnect(subscription& s) {
+    obs.remove_observer(s.recv);
+  }
+
+  void emit(int value) {
+    obs.notify_observers(&receiver::on_event, value);
+  }
+};
+
+// Latency distribution of one kind of operation.
+struct latency {
+  obs::histogram hist;
+  std::uint64_t count = 0;
+  std::uint64_t max = 0;
+
+  void add(std::uint64_t ns) {
+    hist.add(obs::histogram::bucket_index(ns), 1);
+    ++count;
+    max = std::max(max, ns);
+  }
+
+  void merge(const latency& other) {
+    for (int i=0; i<obs::histogram::buckets; ++i)
+      hist.add(i, other.hist.count(i));
+    count += other.count;
+    max = std::max(max, other.max);
+  }
+};
+
+struct thread_stats {
+  latency emits;
+  latency connects;
+  latency disconnects;
+};
+
+static std::uint64_t elapsed_ns(clock_type::time_point start,
+                                clock_type::time_point end) {
+  return std::uint64_t(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+template<typename Target>
+static void worker(Target& target, const options& opts, int index,
+                   clock_type::time_point deadline,
+                   thread_stats& stats) {
+  std::minstd_rand rng(index+1);
+  std::uniform_int_distribution<int> dist(0, opts.emit + opts.connect + opts.disconnect - 1);
+  std::vector<subscription> subs;
+
+  for (;;) {
+    const int op = dist(rng);
+    auto t0 = clock_type::now();
+    clock_type::time_point t1;
+
+    if (op < opts.emit) {
+      target.emit(index);
+      t1 = clock_type::now();
+      stats.emits.add(elapsed_ns(t0, t1));
+    }
+    else if (op < opts.emit + opts.connect || subs.empty()) {
+      subscription s = { new receiver, obs::connection() };
+      target.connect(s);
+      t1 = clock_type::now();
+      stats.connects.add(elapsed_ns(t0, t1));
+      subs.push_back(s);
+    }
+    else {
+      std::size_t i = std::size_t(rng()) % subs.size();
+      subscription s = subs[i];
+      subs[i] = subs.back();
+      subs.pop_back();
+
+      t0 = clock_type::now();
+      target.disconnect(s);
+      t1 = clock_type::now();
+      stats.disconnects.add(elapsed_ns(t0, t1));
+      delete s.recv;
+    }
+
+    if (t1 >= deadline)
+      break;
+  }
+
+  for (auto& s : subs) {
+    target.disconnect(s);
+    delete s.recv;
+  }
+}
+
+static void print_latency(const char* name, const latency& l) {
+  std::cout << "  " << std::left << std::setw(12) << name << std::right
+            << " count=" << l.count
+            << " p50=" << l.hist.percentile(50.0)
+            << " p99=" << l.hist.percentile(99.0)
+            << " p999=" << l.hist.percentile(99.9)
+            << " max=" << l.max << " (ns)\n";
+}
+
+template<typename Target>
+static void run(const char* name, const options& opts, bool thread_safe) {
+  Target target;
+  const int nthreads = (thread_safe ? std::max(1, opts.threads): 1);
+
+  std::vector<subscription> initial(opts.slots);
+  for (auto& s : initial) {
+    s.recv = new receiver;
+    target.connect(s);
+  }
+
+  obs::global_metrics().reset();
+
+  std::vector<thread_stats> stats(nthreads);
+  auto start = clock_type::now();
+  auto deadline = start + std::chrono::duration_cast<clock_type::duration>(
+    std::chrono::duration<double>(opts.duration));
+
+  std::vector<std::thread> threads;
+  for (int i=0; i<nthreads; ++i)
+    threads.emplace_back(
+      [&target, &opts, &stats, i, deadline]{
+        worker(target, opts, i, deadline, stats[i]);
+      });
+  for (auto& t : threads)
+    t.join();
+
+  const double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+  const obs::metrics_snapshot m = obs::global_metrics().snapshot();
+
+  for (auto& s : initial) {
+    target.disconnect(s);
+    delete s.recv;
+  }
+
+  thread_stats total;
+  for (auto& s : stats) {
+    total.emits.merge(s.emits);
+    total.connects.merge(s.connects);
+    total.disconnects.merge(s.disconnects);
+  }
+  const std::uint64_t ops = total.emits.count + total.connects.count + total.disconnects.count;
+
+  std::cout << name << ": threads=" << nthreads
+            << " duration=" << std::fixed << std::setprecision(2) << secs << "s"
+            << " ops=" << ops
+            << " ops/sec=" << std::setprecision(0) << double(ops) / secs << "\n"
+            << std::defaultfloat;
+  print_latency("emit", total.emits);
+  print_latency("connect", total.connects);
+  print_latency("disconnect", total.disconnects);
+  std::cout << "  erase waits=" << m.erase_waits
+            << " max=" << m.erase_wait_max << " (ns)\n";
+}
+
+static bool parse_arg(const char* arg, const char* key, std::string& value) {
+  const std::size_t n = std::strlen(key);
+  if (std::strncmp(arg, key, n) != 0 || arg[n] != '=')
+    return false;
+  value = arg+n+1;
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  options opts;
+  for (int i=1; i<argc; ++i) {
+    std::string v;
+    if (parse_arg(argv[i], "--target", v)) opts.target = v;
+    else if (parse_arg(argv[i], "--threads", v)) opts.threads = std::atoi(v.c_str());
+    else if (parse_arg(argv[i], "--duration", v)) opts.duration = std::atof(v.c_str());
+    else if (parse_arg(argv[i], "--slots", v)) opts.slots = std::atoi(v.c_str());
+    else if (parse_arg(argv[i], "--emit", v)) opts.emit = std::atoi(v.c_str());
+    else if (parse_arg(argv[i], "--connect", v)) opts.connect = std::atoi(v.c_str());
+    else if (parse_arg(argv[i], "--disconnect", v)) opts.disconnect = std::atoi(v.c_str());
+    else {
+      std::cerr << "Unknown argument " << argv[i] << "\n";
+      return 1;
+    }
+  }
+  if (opts.emit < 0 || opts.connect < 0 || opts.disconnect < 0 ||
+      opts.emit + opts.connect + opts.disconnect <= 0) {
+    std::cerr << "Invalid operation weights\n";
+    return 1;
+  }
+
+  const bool all = (opts.target == "all");
+  bool found = false;
+  if (all || opts.target == "safe_signal") {
+    run<signal_target<obs::safe_signal<void(int)>>>("safe_signal", opts, true);
+    found = true;
+  }
+  if (all || opts.target == "fast_signal") {
+    run<signal_target<obs::fast_signal<void(int)>>>("fast_signal", opts, false);
+    found = true;
+  }
+  if (all || opts.target == "safe_observers") {
+    run<observers_target<obs::safe_observers<receiver>>>("safe_observers", opts, true);
+    found = true;
+  }
+  if (all || opts.target == "fast_observers") {
+    run<observers_target<obs::fast_observers<receiver>>>("fast_observers", opts, false);
+    found = true;
+  }
+  if (!found) {
+    std::cerr << "Unknown target " << opts.target << "\n";
+    return 1;
+  }
+  return 0;
+}
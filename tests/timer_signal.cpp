@@ -0,0 +1,183 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/timer_signal.h"
+#include "test.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using ms = std::chrono::milliseconds;
+
+void test_one_shot() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  std::string log;
+  obs::connection a = wheel.connect_after(ms(10), [&log]{ log += "a"; });
+  obs::connection b = wheel.connect_after(ms(5), [&log]{ log += "b"; });
+  obs::connection c = wheel.connect_after(ms(0), [&log]{ log += "c"; });
+  EXPECT_EQ(3u, wheel.size());
+
+  EXPECT_EQ(1u, wheel.advance_ticks(1));
+  EXPECT_EQ("c", log);
+  EXPECT_FALSE(c.connected());
+
+  EXPECT_EQ(0u, wheel.advance_ticks(3));
+  EXPECT_EQ(1u, wheel.advance_ticks(1));
+  EXPECT_EQ("cb", log);
+  EXPECT_FALSE(b.connected());
+  EXPECT_TRUE(a.connected());
+
+  EXPECT_EQ(1u, wheel.advance(obs::timer_wheel::time_point() + ms(100)));
+  EXPECT_EQ("cba", log);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(a.connected());
+  EXPECT_TRUE(obs::timer_wheel::time_point() + ms(100) == wheel.now());
+
+  // Delays are rounded up to the next tick
+  obs::timer_wheel wheel10(ms(10), obs::timer_wheel::time_point());
+  int calls = 0;
+  wheel10.connect_after(ms(11), [&calls]{ ++calls; });
+  EXPECT_EQ(0u, wheel10.advance_ticks(1));
+  EXPECT_EQ(1u, wheel10.advance_ticks(1));
+}
+
+void test_periodic() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  int calls = 0;
+  obs::scoped_connection c = wheel.connect_every(ms(3), [&calls]{ ++calls; });
+  wheel.advance_ticks(10);
+  EXPECT_EQ(3, calls);
+  wheel.advance_ticks(2);
+  EXPECT_EQ(4, calls);
+  EXPECT_EQ(1u, wheel.size());
+
+  c.disconnect();
+  EXPECT_TRUE(wheel.empty());
+  wheel.advance_ticks(10);
+  EXPECT_EQ(4, calls);
+}
+
+// Timers in the upper levels of the wheel are called in the right
+// tick.
+void test_long_delays() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  const std::uint64_t delays[] = { 255, 256, 257, 1000, 65535, 65536,
+                                   65537, 70000, 5000000, 1 << 24,
+                                   (1 << 24) + 1 };
+  std::vector<std::uint64_t> fired;
+  obs::connection_group conns;
+  for (std::uint64_t d : delays)
+    conns.add(wheel.connect_after(ms(d), [&fired, &wheel]{
+                                    fired.push_back(std::uint64_t(
+                                      (wheel.now() - obs::timer_wheel::time_point()) / ms(1)));
+                                  }));
+  wheel.advance_ticks(20000000);
+  EXPECT_EQ(sizeof(delays)/sizeof(delays[0]), fired.size());
+  for (std::size_t i=0; i<fired.size(); ++i)
+    EXPECT_EQ(delays[i], fired[i]);
+
+  // Same delays from a tick that is not aligned to the slots
+  fired.clear();
+  wheel.advance_ticks(12345);
+  const std::uint64_t start = 20000000 + 12345;
+  for (std::uint64_t d : delays)
+    conns.add(wheel.connect_after(ms(d), [&fired, &wheel]{
+                                    fired.push_back(std::uint64_t(
+                                      (wheel.now() - obs::timer_wheel::time_point()) / ms(1)));
+                                  }));
+  wheel.advance_ticks(20000000);
+  EXPECT_EQ(sizeof(delays)/sizeof(delays[0]), fired.size());
+  for (std::size_t i=0; i<fired.size(); ++i)
+    EXPECT_EQ(start + delays[i], fired[i]);
+}
+
+// Timers can be disconnected from the functions of other timers (or
+// from their own function).
+void test_disconnect_from_timer() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  std::string log;
+  obs::connection b, self;
+  obs::scoped_connection a =
+    wheel.connect_after(ms(1), [&]{ log += "a"; b.disconnect(); });
+  b = wheel.connect_after(ms(1), [&]{ log += "b"; });
+  self = wheel.connect_every(ms(1), [&]{ log += "s"; self.disconnect(); });
+  wheel.advance_ticks(5);
+  EXPECT_EQ("as", log);
+  EXPECT_TRUE(wheel.empty());
+}
+
+void test_group() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  int calls = 0;
+  {
+    obs::connection_group group;
+    for (int i=0; i<100; ++i)
+      group.add(wheel.connect_after(ms(i*10), [&calls]{ ++calls; }));
+    obs::scoped_connection other = wheel.connect_after(ms(5), [&calls]{ ++calls; });
+    wheel.advance_ticks(1);
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(100u, wheel.size());
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
+// Connections to timers of a destroyed wheel are disconnected.
+void test_destroy_wheel() {
+  obs::connection c;
+  {
+    obs::timer_wheel wheel;
+    c = wheel.connect_after(ms(1000), []{ });
+    EXPECT_TRUE(c.connected());
+  }
+  EXPECT_FALSE(c.connected());
+  c.disconnect();
+}
+
+void test_timer_signal() {
+  obs::timer_wheel wheel(ms(1), obs::timer_wheel::time_point());
+  int timeouts = 0;
+  obs::timer_signal timeout(wheel);
+  obs::scoped_connection c = timeout.connect([&timeouts]{ ++timeouts; });
+  EXPECT_FALSE(timeout.active());
+
+  timeout.start_after(ms(10));
+  EXPECT_TRUE(timeout.active());
+  wheel.advance_ticks(5);
+
+  // Restarting the timer
+  timeout.start_after(ms(10));
+  wheel.advance_ticks(9);
+  EXPECT_EQ(0, timeouts);
+  wheel.advance_ticks(1);
+  EXPECT_EQ(1, timeouts);
+  EXPECT_FALSE(timeout.active());
+
+  timeout.start_every(ms(2));
+  wheel.advance_ticks(6);
+  EXPECT_EQ(4, timeouts);
+  timeout.stop();
+  wheel.advance_ticks(6);
+  EXPECT_EQ(4, timeouts);
+
+  // The timer is cancelled when the signal is destroyed
+  {
+    obs::timer_signal heartbeat(wheel);
+    heartbeat.start_every(ms(1));
+    EXPECT_EQ(1u, wheel.size());
+  }
+  EXPECT_TRUE(wheel.empty());
+}
+
+int main() {
+  test_one_shot();
+  test_periodic();
+  test_long_delays();
+  test_disconnect_from_timer();
+  test_group();
+  test_destroy_wheel();
+  test_timer_signal();
+}
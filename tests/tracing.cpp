@@ -0,0 +1,105 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifndef OBSERVABLE_TRACING
+  #error OBSERVABLE_TRACING must be defined to compile this test
+#endif
+
+static int count(const std::string& str, const std::string& sub) {
+  int n = 0;
+  for (std::size_t pos=str.find(sub); pos != std::string::npos;
+       pos=str.find(sub, pos+1))
+    ++n;
+  return n;
+}
+
+static std::string export_trace() {
+  std::ostringstream os;
+  obs::tracing::export_chrome_trace(os);
+  return os.str();
+}
+
+int main() {
+  obs::signal<void(int)> sig;
+  obs::signal<void()> nested;
+  sig.set_name("main \"signal\"");
+  nested.set_name("nested");
+  obs::scoped_connection c1 = sig.connect([&nested](int){ nested(); });
+  obs::scoped_connection c2 = nested.connect([]{ });
+
+  // Disabled at runtime
+  sig(1);
+  EXPECT_EQ(0, count(export_trace(), "\"ph\""));
+
+  obs::tracing::enable(true);
+  sig(1);
+  obs::tracing::enable(false);
+  sig(1);
+
+  std::string trace = export_trace();
+  EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+  EXPECT_EQ(8, count(trace, "\"ph\""));
+  EXPECT_EQ(4, count(trace, "\"ph\":\"B\""));
+  EXPECT_EQ(4, count(trace, "\"cat\":\"slot\""));
+  EXPECT_EQ(2, count(trace, "\"name\":\"main \\\"signal\\\"\""));
+  EXPECT_EQ(2, count(trace, "\"name\":\"nested\""));
+  // The nested emission is inside the slot of the main signal
+  EXPECT_TRUE(trace.find("\"name\":\"main") < trace.find("\"name\":\"nested"));
+
+  obs::tracing::clear();
+  EXPECT_EQ(0, count(export_trace(), "\"ph\""));
+
+  // Ring buffer of a new thread with just 4 records, only the last 4
+  // events are kept.
+  obs::tracing::set_buffer_capacity(4);
+  obs::tracing::enable(true);
+  std::thread([&sig]{
+                for (int i=0; i<10; ++i)
+                  sig(i);
+              }).join();
+  obs::tracing::enable(false);
+  trace = export_trace();
+  EXPECT_EQ(4, count(trace, "\"ph\""));
+  EXPECT_EQ(4, count(trace, "\"tid\":1"));
+
+  // A capacity of 0 is used as 1
+  obs::tracing::clear();
+  obs::tracing::set_buffer_capacity(0);
+  obs::tracing::enable(true);
+  std::thread([&sig]{ sig(1); }).join();
+  obs::tracing::enable(false);
+  EXPECT_EQ(1, count(export_trace(), "\"tid\":2"));
+
+  // Export while other thread is adding records to its ring buffer,
+  // records that are overwritten while they're read are discarded.
+  obs::tracing::clear();
+  obs::tracing::set_buffer_capacity(64);
+  obs::tracing::enable(true);
+  std::atomic<bool> done(false);
+  std::atomic<int> emits(0);
+  std::thread writer([&sig, &done, &emits]{
+                       while (!done || emits < 64) {
+                         sig(1);
+                         ++emits;
+                       }
+                     });
+  for (int i=0; i<100; ++i) {
+    trace = export_trace();
+    EXPECT_TRUE(count(trace, "\"tid\":3") <= 64);
+  }
+  done = true;
+  writer.join();
+  obs::tracing::enable(false);
+  EXPECT_EQ(64, count(export_trace(), "\"tid\":3"));
+}
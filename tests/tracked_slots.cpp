@@ -0,0 +1,131 @@
+// Observable Library
+// Copyright (c) 2026-present David Capello
+//
+// This file is released under the terms of the MIT license.
+// Read LICENSE.txt for more information.
+
+#include "obs/signal.h"
+#include "test.h"
+
+#include <memory>
+#include <vector>
+
+struct Receiver {
+  int count = 0;
+  void on_signal(int v) { count += v; }
+};
+
+template<typename Signal>
+void test_tracked_slots() {
+  Signal sig;
+  int calls = 0;
+
+  auto a = std::make_shared<Receiver>();
+  auto b = std::make_shared<Receiver>();
+  sig.connect(&Receiver::on_signal, a);
+  sig.connect(&Receiver::on_signal, b);
+  sig.connect(std::weak_ptr<Receiver>(b), [&calls](int){ ++calls; });
+
+  sig(1);
+  EXPECT_EQ(1, a->count);
+  EXPECT_EQ(1, b->count);
+  EXPECT_EQ(1, calls);
+
+  // The slots of "b" are skipped and deleted after it's destroyed
+  std::weak_ptr<Receiver> weak_b = b;
+  b.reset();
+  EXPECT_TRUE(weak_b.expired());
+  sig(2);
+  EXPECT_EQ(3, a->count);
+  EXPECT_EQ(1, calls);
+
+  a.reset();
+  sig(3);
+  EXPECT_FALSE(sig);
+}
+
+// Receivers destroyed from a slot in the same emission
+template<typename Signal>
+void test_expire_on_signal() {
+  Signal sig;
+  std::vector<std::shared_ptr<Receiver>> receivers;
+  for (int i=0; i<8; ++i) {
+    receivers.push_back(std::make_shared<Receiver>());
+    sig.connect(&Receiver::on_signal, receivers.back());
+  }
+  obs::connection conn =
+    sig.connect([&receivers](int){ receivers.clear(); });
+
+  sig(1);
+  conn.disconnect();
+
+  // Expired slots are deleted in the next emission
+  EXPECT_TRUE(sig);
+  sig(1);
+  EXPECT_FALSE(sig);
+}
+
+// Tracked slots return a connection like other slots.
+template<typename Signal>
+void test_tracked_connections() {
+  Signal sig;
+  auto a = std::make_shared<Receiver>();
+  obs::connection c = sig.connect(&Receiver::on_signal, a);
+  EXPECT_TRUE(c.connected());
+
+  c.block();
+  sig(1);
+  EXPECT_EQ(0, a->count);
+  c.unblock();
+  sig(1);
+  EXPECT_EQ(1, a->count);
+
+  // Disconnected before the owner is destroyed
+  c.disconnect();
+  sig(1);
+  EXPECT_EQ(1, a->count);
+  EXPECT_FALSE(sig);
+
+  // In a group
+  int calls = 0;
+  {
+    obs::connection_group group;
+    group.add(sig.connect(a, [&calls](int){ ++calls; }));
+    group.add(sig.connect(std::weak_ptr<Receiver>(a), [&calls](int){ ++calls; }));
+    sig(1);
+    EXPECT_EQ(2, calls);
+  }
+  sig(1);
+  EXPECT_EQ(2, calls);
+  EXPECT_FALSE(sig);
+
+  // The connection is invalidated when the expired slot is deleted
+  c = sig.connect(&Receiver::on_signal, a);
+  a.reset();
+  EXPECT_TRUE(c.connected());
+  sig(1);
+  EXPECT_FALSE(c.connected());
+  c.disconnect();
+  EXPECT_FALSE(sig);
+}
+
+int main() {
+  test_tracked_slots<obs::safe_signal<void(int)>>();
+  test_tracked_slots<obs::fast_signal<void(int)>>();
+  test_expire_on_signal<obs::safe_signal<void(int)>>();
+  test_expire_on_signal<obs::fast_signal<void(int)>>();
+  test_tracked_connections<obs::safe_signal<void(int)>>();
+  test_tracked_connections<obs::fast_signal<void(int)>>();
+  test_tracked_connections<obs::cow_signal<void(int)>>();
+
+  // Non-void signals
+  {
+    obs::signal<int(int)> sig;
+    auto owner = std::make_shared<int>(0);
+    sig.connect([](int v){ return v; });
+    sig.connect(owner, [](int v){ return v*2; });
+    EXPECT_EQ(4, sig(2));
+    owner.reset();
+    EXPECT_EQ(2, sig(2));
+  }
+}